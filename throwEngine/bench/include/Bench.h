@@ -0,0 +1,96 @@
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+/*
+ * Minimal benchmark harness for throw_bench, no third party dependency.
+ *
+ * A case is a function run once per repetition at a given size n. It does its own setup and
+ * teardown and wraps the part being measured in timer.start() / timer.stop(), so only that part
+ * is counted. Every case runs at each of SIZES: one warm-up repetition, then repetitions until
+ * both Options::minRepetitions and Options::minSeconds are reached (or maxRepetitions).
+ * Results are reported per repetition (min / median / mean) and per item (median / n).
+ */
+namespace BENCH
+{
+	inline constexpr size_t SIZES[] = { 1'000, 10'000, 100'000 };
+
+	class Timer
+	{
+	public:
+		void start() { m_begin = Clock::now(); };
+		void stop() { m_elapsed += Clock::now() - m_begin; };
+
+		[[nodiscard]] double getNanoseconds() const { return std::chrono::duration<double, std::nano>(m_elapsed).count(); };
+
+	private:
+		using Clock = std::chrono::steady_clock;
+
+		Clock::time_point m_begin{};
+		Clock::duration m_elapsed{};
+	};
+
+	using CaseFunc = std::function<void(size_t n, Timer& timer)>;
+
+	struct Options
+	{
+		// only cases whose name contains this substring run
+		std::string filter;
+		size_t minRepetitions = 3;
+		size_t maxRepetitions = 1000;
+		double minSeconds = 0.25;
+	};
+
+	struct Result
+	{
+		std::string name;
+		size_t size;
+		size_t repetitions;
+		double minNs;
+		double medianNs;
+		double meanNs;
+	};
+
+	class Registry
+	{
+	public:
+		// name is "Group/case", it is used as is in the JSON output and by the filter
+		void add(std::string name, CaseFunc func);
+
+		// progress goes to std::cerr, stdout is left for the JSON
+		[[nodiscard]] std::vector<Result> run(const Options& options) const;
+
+	private:
+		struct Case
+		{
+			std::string name;
+			CaseFunc func;
+		};
+
+		std::vector<Case> m_cases;
+	};
+
+	void writeJson(std::ostream& out, const std::vector<Result>& results);
+
+	// keeps the compiler from discarding a result that is otherwise unused
+	template<typename T>
+	inline void doNotOptimize(const T& value)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "r,m"(value) : "memory");
+#else
+		const volatile void* volatile sink = &value;
+		static_cast<void>(sink);
+#endif
+	}
+
+	// one per translation unit under bench/src
+	void registerECSBenchmarks(Registry& registry);
+	void registerSceneBenchmarks(Registry& registry);
+	void registerGraphicsBenchmarks(Registry& registry);
+	void registerSpatialBenchmarks(Registry& registry);
+}
@@ -0,0 +1,117 @@
+#include "Bench.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <thread>
+#include "Math/SIMD.h"
+
+namespace
+{
+	std::string escapeJson(const std::string& text)
+	{
+		std::string escaped;
+		escaped.reserve(text.size());
+		for (const char c : text) {
+			if (c == '"' || c == '\\') escaped += '\\';
+			escaped += c;
+		}
+		return escaped;
+	}
+
+	std::string compilerName()
+	{
+#if defined(__clang__)
+		return "clang " __clang_version__;
+#elif defined(__GNUC__)
+		return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+		return "msvc " + std::to_string(_MSC_VER);
+#else
+		return "unknown";
+#endif
+	}
+}
+
+namespace BENCH
+{
+	void Registry::add(std::string name, CaseFunc func)
+	{
+		m_cases.push_back(Case{ std::move(name), std::move(func) });
+	}
+
+	std::vector<Result> Registry::run(const Options& options) const
+	{
+		std::vector<Result> results;
+
+		for (const auto& benchCase : m_cases) {
+			if (!options.filter.empty() && benchCase.name.find(options.filter) == std::string::npos) continue;
+
+			for (const size_t n : SIZES) {
+				// warm-up, fills caches and the allocator, not recorded
+				Timer warmUp;
+				benchCase.func(n, warmUp);
+
+				std::vector<double> samples;
+				double totalNs = 0.0;
+				while (samples.size() < options.maxRepetitions &&
+					(samples.size() < options.minRepetitions || totalNs < options.minSeconds * 1e9)) {
+					Timer timer;
+					benchCase.func(n, timer);
+					samples.push_back(timer.getNanoseconds());
+					totalNs += samples.back();
+				}
+
+				std::sort(samples.begin(), samples.end());
+				const size_t middle = samples.size() / 2;
+				const double median = samples.size() % 2 ? samples[middle] : (samples[middle - 1] + samples[middle]) * 0.5;
+
+				results.push_back(Result{
+					.name = benchCase.name,
+					.size = n,
+					.repetitions = samples.size(),
+					.minNs = samples.front(),
+					.medianNs = median,
+					.meanNs = totalNs / static_cast<double>(samples.size()),
+				});
+
+				std::cerr << std::left << std::setw(40) << benchCase.name << std::right << std::setw(8) << n
+					<< std::fixed << std::setprecision(2) << std::setw(14) << median / static_cast<double>(n) << " ns/item  ("
+					<< samples.size() << " reps)\n";
+			}
+		}
+		return results;
+	}
+
+	void writeJson(std::ostream& out, const std::vector<Result>& results)
+	{
+		out << std::setprecision(17);
+		out << "{\n";
+		out << "  \"context\": {\n";
+		out << "    \"compiler\": \"" << escapeJson(compilerName()) << "\",\n";
+#if defined(NDEBUG)
+		out << "    \"build\": \"release\",\n";
+#else
+		out << "    \"build\": \"debug\",\n";
+#endif
+		out << "    \"simd_width\": " << MATH::SIMD::kernelWidth() << ",\n";
+		out << "    \"hardware_threads\": " << std::thread::hardware_concurrency() << "\n";
+		out << "  },\n";
+		out << "  \"benchmarks\": [";
+
+		for (size_t i = 0; i < results.size(); ++i) {
+			const auto& result = results[i];
+			out << (i ? ",\n" : "\n");
+			out << "    { \"name\": \"" << escapeJson(result.name) << "\""
+				<< ", \"size\": " << result.size
+				<< ", \"repetitions\": " << result.repetitions
+				<< ", \"min_ns\": " << result.minNs
+				<< ", \"median_ns\": " << result.medianNs
+				<< ", \"mean_ns\": " << result.meanNs
+				<< ", \"ns_per_item\": " << result.medianNs / static_cast<double>(result.size)
+				<< " }";
+		}
+		out << "\n  ]\n}\n";
+	}
+}
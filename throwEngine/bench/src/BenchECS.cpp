@@ -0,0 +1,118 @@
+#include "Bench.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "ComponentStorage.h"
+#include "World.h"
+
+namespace
+{
+	struct Position { float x, y, z; };
+	struct Velocity { float x, y, z; };
+
+	// the handles a fresh World hands out (slot 0 is reserved)
+	std::vector<Entity> makeEntities(size_t n)
+	{
+		std::vector<Entity> entities(n);
+		for (size_t i = 0; i < n; ++i) entities[i] = ECS::makeEntity(static_cast<uint32_t>(i + 1), 0);
+		return entities;
+	}
+
+	// random access order, fixed seed so every run touches memory the same way
+	std::vector<Entity> shuffled(std::vector<Entity> entities)
+	{
+		std::mt19937 rng(1234);
+		std::shuffle(entities.begin(), entities.end(), rng);
+		return entities;
+	}
+
+	void fill(ComponentStorage<Position>& storage, const std::vector<Entity>& entities)
+	{
+		storage.reserve(entities.size());
+		for (size_t i = 0; i < entities.size(); ++i) {
+			const float f = static_cast<float>(i);
+			storage.add(entities[i], Position{ f, f, f }, 1);
+		}
+	}
+}
+
+namespace BENCH
+{
+	void registerECSBenchmarks(Registry& registry)
+	{
+		registry.add("ComponentStorage/add", [](size_t n, Timer& timer) {
+			const auto entities = makeEntities(n);
+			ComponentStorage<Position> storage;
+
+			timer.start();
+			for (size_t i = 0; i < n; ++i) {
+				const float f = static_cast<float>(i);
+				storage.add(entities[i], Position{ f, f, f }, 1);
+			}
+			timer.stop();
+			doNotOptimize(storage.size());
+		});
+
+		registry.add("ComponentStorage/get", [](size_t n, Timer& timer) {
+			const auto entities = makeEntities(n);
+			const auto order = shuffled(entities);
+			ComponentStorage<Position> storage;
+			fill(storage, entities);
+
+			float sum = 0.0f;
+			timer.start();
+			for (const Entity e : order) sum += storage.get(e)->x;
+			timer.stop();
+			doNotOptimize(sum);
+		});
+
+		registry.add("ComponentStorage/remove", [](size_t n, Timer& timer) {
+			const auto entities = makeEntities(n);
+			const auto order = shuffled(entities);
+			ComponentStorage<Position> storage;
+			fill(storage, entities);
+
+			timer.start();
+			for (const Entity e : order) storage.remove(e);
+			timer.stop();
+			doNotOptimize(storage.size());
+		});
+
+		registry.add("ComponentStorage/iterate", [](size_t n, Timer& timer) {
+			ComponentStorage<Position> storage;
+			fill(storage, makeEntities(n));
+
+			float sum = 0.0f;
+			timer.start();
+			for (const auto& position : storage.getAll()) sum += position.x + position.y + position.z;
+			timer.stop();
+			doNotOptimize(sum);
+		});
+
+		registry.add("World/createEntity", [](size_t n, Timer& timer) {
+			World world;
+
+			timer.start();
+			for (size_t i = 0; i < n; ++i) doNotOptimize(world.createEntity());
+			timer.stop();
+		});
+
+		// two components each, so every delete also goes through the pools
+		registry.add("World/deleteEntity", [](size_t n, Timer& timer) {
+			World world;
+			std::vector<Entity> entities(n);
+			for (auto& e : entities) {
+				e = world.createEntity();
+				world.addComponent(e, Position{ 1.0f, 2.0f, 3.0f });
+				world.addComponent(e, Velocity{ 0.0f, 1.0f, 0.0f });
+			}
+			entities = shuffled(std::move(entities));
+
+			timer.start();
+			for (const Entity e : entities) world.deleteEntity(e);
+			timer.stop();
+			doNotOptimize(world.getAliveCount());
+		});
+	}
+}
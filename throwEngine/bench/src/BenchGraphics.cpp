@@ -0,0 +1,106 @@
+#include "Bench.h"
+
+#include <random>
+#include <vector>
+#include "graphics/Mesh/MeshData3D.h"
+#include "graphics/Mesh/MeshFactory.h"
+#include "graphics/Renderer/RenderQueue.h"
+#include "graphics/Transformations/TransformPool.h"
+#include "graphics/Transformations/Transformations.h"
+
+namespace
+{
+	std::vector<Transform> makeTransforms(size_t n)
+	{
+		std::vector<Transform> transforms(n);
+		for (size_t i = 0; i < n; ++i) {
+			const float f = static_cast<float>(i);
+			transforms[i].setPosition(glm::vec3(f, 0.0f, -f));
+			transforms[i].setScale(glm::vec3(1.0f + f * 0.001f));
+		}
+		return transforms;
+	}
+}
+
+namespace BENCH
+{
+	void registerGraphicsBenchmarks(Registry& registry)
+	{
+		// every transform dirty, so each call rebuilds its matrix
+		registry.add("Transform/getModelMatrix", [](size_t n, Timer& timer) {
+			auto transforms = makeTransforms(n);
+			for (size_t i = 0; i < n; ++i) transforms[i].setRotation(glm::vec3(static_cast<float>(i % 360), 45.0f, 10.0f));
+
+			float sum = 0.0f;
+			timer.start();
+			for (auto& transform : transforms) sum += transform.getModelMatrix()[3][0];
+			timer.stop();
+			doNotOptimize(sum);
+		});
+
+		registry.add("Transform/getModelMatrixCached", [](size_t n, Timer& timer) {
+			auto transforms = makeTransforms(n);
+			for (auto& transform : transforms) doNotOptimize(transform.getModelMatrix());
+
+			float sum = 0.0f;
+			timer.start();
+			for (auto& transform : transforms) sum += transform.getModelMatrix()[3][0];
+			timer.stop();
+			doNotOptimize(sum);
+		});
+
+		// same work as Transform/getModelMatrix through the batched SoA path, single threaded
+		registry.add("TransformPool/updateMatrices", [](size_t n, Timer& timer) {
+			Graphics::TransformPool pool;
+			pool.reserve(n);
+			for (size_t i = 0; i < n; ++i) {
+				const float f = static_cast<float>(i);
+				pool.create(glm::vec3(f, 0.0f, -f), glm::vec3(static_cast<float>(i % 360), 45.0f, 10.0f), glm::vec3(1.0f + f * 0.001f));
+			}
+
+			timer.start();
+			doNotOptimize(pool.updateMatrices());
+			timer.stop();
+		});
+
+		// a frame's draw keys: 3 shaders, 20 materials, 5 meshes, objects up to 500 units away
+		registry.add("RenderQueue/sort", [](size_t n, Timer& timer) {
+			std::mt19937 rng(1234);
+			std::vector<uint64_t> keys(n);
+			for (auto& key : keys) {
+				key = Render::SortKey::makeState(Render::SortKey::Pass::Opaque, rng() % 3, 0, rng() % 5, rng() % 20)
+					| Render::SortKey::depthBits(static_cast<float>(rng() % 500000) * 0.001f);
+			}
+			Render::RenderQueue queue;
+			queue.reserve(n);
+
+			timer.start();
+			for (size_t i = 0; i < n; ++i) queue.push(keys[i], static_cast<uint32_t>(i));
+			queue.sort();
+			timer.stop();
+			doNotOptimize(queue.getSortPassCount());
+		});
+
+		// n meshes generated per repetition
+		registry.add("MeshFactory/createCube", [](size_t n, Timer& timer) {
+			timer.start();
+			for (size_t i = 0; i < n; ++i) doNotOptimize(Graphics::MeshFactory::createCube());
+			timer.stop();
+		});
+
+		registry.add("MeshFactory/createSphere", [](size_t n, Timer& timer) {
+			timer.start();
+			for (size_t i = 0; i < n; ++i) doNotOptimize(Graphics::MeshFactory::createSphere());
+			timer.stop();
+		});
+
+		// by name through the factory's lookup table, the way the engine builds its meshes
+		registry.add("MeshFactory/createMeshObject", [](size_t n, Timer& timer) {
+			Graphics::MeshFactory factory;
+
+			timer.start();
+			for (size_t i = 0; i < n; ++i) doNotOptimize(factory.createMeshObject(i % 2 ? "cube" : "sphere"));
+			timer.stop();
+		});
+	}
+}
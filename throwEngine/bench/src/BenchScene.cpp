@@ -0,0 +1,100 @@
+#include "Bench.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "World.h"
+#include "Scene/Scene.h"
+#include "graphics/Mesh/MeshData3D.h"
+#include "graphics/Transformations/TransformPool.h"
+
+namespace
+{
+	// descriptions are built before the timer starts, only the scene bookkeeping is measured
+	// (entity, component and transform pool churn). No GPU resources are touched
+	std::vector<SCENE::SceneObjectDesc> makeDescs(size_t n)
+	{
+		std::vector<SCENE::SceneObjectDesc> descs(n);
+		for (size_t i = 0; i < n; ++i) {
+			descs[i].name = core::NameId("object_" + std::to_string(i));
+			descs[i].subMeshName = "cube";
+			descs[i].position = glm::vec3(static_cast<float>(i), 0.0f, 0.0f);
+		}
+		return descs;
+	}
+
+	struct SceneFixture
+	{
+		World world;
+		std::shared_ptr<Graphics::TransformPool> transformPool = std::make_shared<Graphics::TransformPool>();
+		SCENE::Scene scene{ world, transformPool, std::make_shared<Graphics::MeshData3D>(), Input::InputContext{} };
+	};
+}
+
+namespace BENCH
+{
+	void registerSceneBenchmarks(Registry& registry)
+	{
+		registry.add("Scene/createObjectProperties", [](size_t n, Timer& timer) {
+			const auto descs = makeDescs(n);
+			const auto fixture = std::make_unique<SceneFixture>();
+
+			timer.start();
+			for (const auto& desc : descs) doNotOptimize(fixture->scene.createObjectProperties(desc));
+			timer.stop();
+			doNotOptimize(fixture->scene.getObjectCount());
+		});
+
+		// the same objects through the batch path (unnamed, containers reserved once)
+		registry.add("Scene/createObjects", [](size_t n, Timer& timer) {
+			std::vector<glm::vec3> positions(n);
+			for (size_t i = 0; i < n; ++i) positions[i] = glm::vec3(static_cast<float>(i), 0.0f, 0.0f);
+			const SCENE::SceneObjectDesc prototype{ .subMeshName = "cube" };
+			const auto fixture = std::make_unique<SceneFixture>();
+
+			timer.start();
+			const auto handles = fixture->scene.createObjects(prototype, positions);
+			timer.stop();
+			doNotOptimize(handles.size());
+		});
+
+		registry.add("Scene/destroyObject", [](size_t n, Timer& timer) {
+			const auto descs = makeDescs(n);
+			const auto fixture = std::make_unique<SceneFixture>();
+			for (const auto& desc : descs) (void)fixture->scene.createObjectProperties(desc);
+
+			timer.start();
+			for (const auto& desc : descs) fixture->scene.destroyObject(desc.name);
+			timer.stop();
+			doNotOptimize(fixture->scene.getObjectCount());
+		});
+
+		// a full scene where every object is destroyed and created again, exercises entity and transform slot recycling
+		registry.add("Scene/churn", [](size_t n, Timer& timer) {
+			const auto descs = makeDescs(n);
+			const auto fixture = std::make_unique<SceneFixture>();
+			for (const auto& desc : descs) (void)fixture->scene.createObjectProperties(desc);
+
+			timer.start();
+			for (const auto& desc : descs) {
+				fixture->scene.destroyObject(desc.name);
+				(void)fixture->scene.createObjectProperties(desc);
+			}
+			timer.stop();
+			doNotOptimize(fixture->scene.getObjectCount());
+		});
+
+		// what the ImGui panels do every frame
+		registry.add("Scene/forEachObject", [](size_t n, Timer& timer) {
+			const auto descs = makeDescs(n);
+			const auto fixture = std::make_unique<SceneFixture>();
+			for (const auto& desc : descs) (void)fixture->scene.createObjectProperties(desc);
+
+			size_t nameBytes = 0;
+			timer.start();
+			fixture->scene.forEachObject([&](const SCENE::SceneObject& object) { nameBytes += object.getName().size(); });
+			timer.stop();
+			doNotOptimize(nameBytes);
+		});
+	}
+}
@@ -0,0 +1,229 @@
+#include "Bench.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+#include <glm/gtc/matrix_transform.hpp>
+#include "Math/AABB.h"
+#include "Math/Frustum.h"
+#include "Spatial/DynamicBVH.h"
+#include "Spatial/SpatialHashGrid.h"
+
+namespace
+{
+	// unit-ish boxes scattered over a cube that grows with n, so the density stays about the same for every size.
+	// spacing is the mean distance between boxes. Fixed seed so every run builds the same tree
+	std::vector<MATH::AABB> makeBoxes(size_t n, uint32_t seed = 1234, float spacing = 4.0f)
+	{
+		std::mt19937 rng(seed);
+		const float extent = std::cbrt(static_cast<float>(n)) * spacing;
+		std::uniform_real_distribution<float> position(-extent, extent);
+		std::uniform_real_distribution<float> size(0.5f, 2.0f);
+
+		std::vector<MATH::AABB> boxes(n);
+		for (auto& box : boxes) {
+			const glm::vec3 min(position(rng), position(rng), position(rng));
+			box = { min, min + glm::vec3(size(rng), size(rng), size(rng)) };
+		}
+		return boxes;
+	}
+
+	// DynamicBVH or SpatialHashGrid, same interface
+	template<typename Index>
+	Index makeIndex(const std::vector<MATH::AABB>& boxes, std::vector<uint32_t>& proxies)
+	{
+		Index index;
+		proxies.resize(boxes.size());
+		for (size_t i = 0; i < boxes.size(); ++i) proxies[i] = index.createProxy(boxes[i], static_cast<uint32_t>(i));
+		return index;
+	}
+
+	SPATIAL::DynamicBVH makeTree(const std::vector<MATH::AABB>& boxes, std::vector<uint32_t>& proxies)
+	{
+		return makeIndex<SPATIAL::DynamicBVH>(boxes, proxies);
+	}
+
+	// every proxy moves 2 units (further than the BVH's fat margin), a frame where everything is animated
+	template<typename Index>
+	void moveAll(size_t n, BENCH::Timer& timer)
+	{
+		const auto boxes = makeBoxes(n);
+		std::vector<uint32_t> proxies;
+		auto index = makeIndex<Index>(boxes, proxies);
+
+		const glm::vec3 step(2.0f, 0.0f, -2.0f);
+		size_t relinked = 0;
+
+		timer.start();
+		for (size_t i = 0; i < n; ++i) {
+			relinked += index.moveProxy(proxies[i], MATH::AABB{ boxes[i].min + step, boxes[i].max + step });
+		}
+		timer.stop();
+		BENCH::doNotOptimize(relinked);
+	}
+}
+
+namespace BENCH
+{
+	void registerSpatialBenchmarks(Registry& registry)
+	{
+		registry.add("BVH/createProxy", [](size_t n, Timer& timer) {
+			const auto boxes = makeBoxes(n);
+			SPATIAL::DynamicBVH bvh;
+
+			timer.start();
+			for (size_t i = 0; i < n; ++i) doNotOptimize(bvh.createProxy(boxes[i], static_cast<uint32_t>(i)));
+			timer.stop();
+			doNotOptimize(bvh.getHeight());
+		});
+
+		// every proxy moves a little (inside its fat box) and every 8th one jumps, like a frame of a mostly static scene
+		registry.add("BVH/moveProxy", [](size_t n, Timer& timer) {
+			const auto boxes = makeBoxes(n);
+			const auto moved = makeBoxes(n, 4321);
+			std::vector<uint32_t> proxies;
+			auto bvh = makeTree(boxes, proxies);
+
+			const glm::vec3 nudge(0.1f);
+			size_t reinserted = 0;
+
+			timer.start();
+			for (size_t i = 0; i < n; ++i) {
+				const MATH::AABB box = i % 8 == 0 ? moved[i] : MATH::AABB{ boxes[i].min + nudge, boxes[i].max + nudge };
+				reinserted += bvh.moveProxy(proxies[i], box);
+			}
+			timer.stop();
+			doNotOptimize(reinserted);
+		});
+
+		registry.add("BVH/moveAll", moveAll<SPATIAL::DynamicBVH>);
+		registry.add("Grid/moveAll", moveAll<SPATIAL::SpatialHashGrid>);
+
+		registry.add("Grid/createProxy", [](size_t n, Timer& timer) {
+			const auto boxes = makeBoxes(n);
+			SPATIAL::SpatialHashGrid grid;
+
+			timer.start();
+			for (size_t i = 0; i < n; ++i) doNotOptimize(grid.createProxy(boxes[i], static_cast<uint32_t>(i)));
+			timer.stop();
+			doNotOptimize(grid.getCellCount());
+		});
+
+		// n rays between random points, what picking does once per click
+		registry.add("BVH/raycastClosest", [](size_t n, Timer& timer) {
+			const auto boxes = makeBoxes(n);
+			const auto origins = makeBoxes(n, 99);
+			const auto targets = makeBoxes(n, 77);
+			std::vector<uint32_t> proxies;
+			const auto bvh = makeTree(boxes, proxies);
+
+			size_t hits = 0;
+
+			timer.start();
+			for (size_t i = 0; i < n; ++i) {
+				hits += bvh.raycastClosest(origins[i].min, targets[i].min - origins[i].min).hit;
+			}
+			timer.stop();
+			doNotOptimize(hits);
+		});
+
+		registry.add("BVH/nearest", [](size_t n, Timer& timer) {
+			const auto boxes = makeBoxes(n);
+			const auto points = makeBoxes(n, 99);
+			std::vector<uint32_t> proxies;
+			const auto bvh = makeTree(boxes, proxies);
+
+			uint32_t sum = 0;
+
+			timer.start();
+			for (const auto& point : points) sum += bvh.nearest(point.min).userData;
+			timer.stop();
+			doNotOptimize(sum);
+		});
+
+		registry.add("Grid/nearest", [](size_t n, Timer& timer) {
+			const auto boxes = makeBoxes(n);
+			const auto points = makeBoxes(n, 99);
+			std::vector<uint32_t> proxies;
+			const auto grid = makeIndex<SPATIAL::SpatialHashGrid>(boxes, proxies);
+
+			uint32_t sum = 0;
+
+			timer.start();
+			for (const auto& point : points) sum += grid.nearest(point.min).userData;
+			timer.stop();
+			doNotOptimize(sum);
+		});
+
+		// boxes ~40 units apart, five cells, so nearly every occupied cell is alone. The ring search stays a few
+		// rings deep at any n, per-query cost must not grow with the number of occupied cells
+		registry.add("Grid/nearestSparse", [](size_t n, Timer& timer) {
+			const auto boxes = makeBoxes(n, 1234, 40.0f);
+			const auto points = makeBoxes(1000, 99, 40.0f * std::cbrt(static_cast<float>(n) / 1000.0f));
+			std::vector<uint32_t> proxies;
+			const auto grid = makeIndex<SPATIAL::SpatialHashGrid>(boxes, proxies);
+
+			uint32_t sum = 0;
+
+			timer.start();
+			for (const auto& point : points) sum += grid.nearest(point.min).userData;
+			timer.stop();
+			doNotOptimize(sum);
+		});
+
+		// same rays as BVH/raycastClosest, clipped to 50 units like a pick ray into a busy area
+		registry.add("Grid/raycastClosest", [](size_t n, Timer& timer) {
+			const auto boxes = makeBoxes(n);
+			const auto origins = makeBoxes(n, 99);
+			const auto targets = makeBoxes(n, 77);
+			std::vector<uint32_t> proxies;
+			const auto grid = makeIndex<SPATIAL::SpatialHashGrid>(boxes, proxies);
+
+			size_t hits = 0;
+
+			timer.start();
+			for (size_t i = 0; i < n; ++i) {
+				const glm::vec3 direction = glm::normalize(targets[i].min - origins[i].min);
+				hits += grid.raycastClosest(origins[i].min, direction, 50.0f).hit;
+			}
+			timer.stop();
+			doNotOptimize(hits);
+		});
+
+		registry.add("Grid/querySphere", [](size_t n, Timer& timer) {
+			const auto boxes = makeBoxes(n);
+			const auto centers = makeBoxes(n, 99);
+			std::vector<uint32_t> proxies;
+			const auto grid = makeIndex<SPATIAL::SpatialHashGrid>(boxes, proxies);
+
+			size_t found = 0;
+
+			timer.start();
+			for (const auto& center : centers) {
+				grid.querySphere(center.min, 5.0f, [&found](uint32_t) { ++found; return true; });
+			}
+			timer.stop();
+			doNotOptimize(found);
+		});
+
+		// camera at the origin looking down -z over the box cloud, about a tenth of the boxes is visible
+		registry.add("Frustum/cullAABBs", [](size_t n, Timer& timer) {
+			const auto boxes = makeBoxes(n);
+			std::vector<float> centerX(n), centerY(n), centerZ(n), extentX(n), extentY(n), extentZ(n);
+			for (size_t i = 0; i < n; ++i) {
+				const glm::vec3 center = boxes[i].getCenter();
+				const glm::vec3 extents = boxes[i].getExtents();
+				centerX[i] = center.x; centerY[i] = center.y; centerZ[i] = center.z;
+				extentX[i] = extents.x; extentY[i] = extents.y; extentZ[i] = extents.z;
+			}
+			std::vector<uint8_t> visible(n);
+			const auto frustum = MATH::Frustum::fromViewProjection(glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 1000.0f));
+
+			timer.start();
+			const size_t visibleCount = MATH::cullAABBs(frustum, centerX.data(), centerY.data(), centerZ.data(),
+				extentX.data(), extentY.data(), extentZ.data(), n, visible.data());
+			timer.stop();
+			doNotOptimize(visibleCount);
+		});
+	}
+}
@@ -0,0 +1,64 @@
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include "Bench.h"
+#include "core/Logger.h"
+#include "Math/SIMD.h"
+
+namespace
+{
+	void printUsage()
+	{
+		std::cerr << "usage: throw_bench [--out <file.json>] [--filter <substring>] [--min-time <seconds>] [--min-reps <count>]\n"
+			<< "  results are written as JSON to stdout unless --out is given\n";
+	}
+}
+
+int main(int argc, char** argv)
+{
+	BENCH::Options options;
+	std::string outPath;
+
+	for (int i = 1; i < argc; ++i) {
+		const bool hasValue = i + 1 < argc;
+		if (std::strcmp(argv[i], "--out") == 0 && hasValue) {
+			outPath = argv[++i];
+		} else if (std::strcmp(argv[i], "--filter") == 0 && hasValue) {
+			options.filter = argv[++i];
+		} else if (std::strcmp(argv[i], "--min-time") == 0 && hasValue) {
+			options.minSeconds = std::stod(argv[++i]);
+		} else if (std::strcmp(argv[i], "--min-reps") == 0 && hasValue) {
+			options.minRepetitions = std::stoul(argv[++i]);
+		} else {
+			printUsage();
+			return std::strcmp(argv[i], "--help") == 0 ? 0 : 1;
+		}
+	}
+
+	if (!MATH::SIMD::kernelsSupported()) {
+		Logger::error("[throw_bench] the engine's SIMD kernels were built with AVX and this CPU has none");
+		return 1;
+	}
+
+	BENCH::Registry registry;
+	BENCH::registerECSBenchmarks(registry);
+	BENCH::registerSceneBenchmarks(registry);
+	BENCH::registerGraphicsBenchmarks(registry);
+	BENCH::registerSpatialBenchmarks(registry);
+
+	const auto results = registry.run(options);
+
+	if (outPath.empty()) {
+		BENCH::writeJson(std::cout, results);
+		return 0;
+	}
+
+	std::ofstream file(outPath);
+	if (!file.is_open()) {
+		Logger::error("[throw_bench] could not open " + outPath);
+		return 1;
+	}
+	BENCH::writeJson(file, results);
+	return 0;
+}
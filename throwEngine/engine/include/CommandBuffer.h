@@ -0,0 +1,182 @@
+#pragma once
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "ComponentType.h"
+#include "Entity.h"
+#include "World.h"
+
+namespace ECS {
+    // entity created through a CommandBuffer, it only becomes a real Entity at playback.
+    // Only valid with the buffer that created it.
+    struct PendingEntity {
+        uint32_t index;
+    };
+
+    // target of a deferred command, either a live entity or a PendingEntity of the same buffer
+    struct CommandTarget {
+        static constexpr uint32_t LIVE = std::numeric_limits<uint32_t>::max();
+
+        Entity entity = NullEntity;
+        uint32_t pending = LIVE;
+
+        [[nodiscard]] Entity resolve(const std::vector<Entity>& created) const {
+            return pending == LIVE ? entity : created[pending];
+        };
+    };
+}
+
+class ICommandQueue;
+
+// one queue of the same component type per buffer, together with the entities that buffer created
+struct CommandSource {
+    ICommandQueue* queue;
+    const std::vector<Entity>* created;
+};
+
+// type-erased per component type command queue, lets playback batch adds/removes type by type
+class ICommandQueue {
+public:
+    virtual ~ICommandQueue() = default;
+
+    // apply the commands of every source (all of this queue's component type) in one sorted batch
+    virtual void playbackAdds(World& world, const std::vector<CommandSource>& sources) = 0;
+    virtual void playbackRemoves(World& world, const std::vector<CommandSource>& sources) = 0;
+
+    [[nodiscard]] virtual bool empty() const = 0;
+    virtual void clear() = 0;
+};
+
+template<typename T>
+class CommandQueue final : public ICommandQueue {
+public:
+    void playbackAdds(World& world, const std::vector<CommandSource>& sources) override;
+    void playbackRemoves(World& world, const std::vector<CommandSource>& sources) override;
+
+    [[nodiscard]] bool empty() const override { return m_adds.empty() && m_removes.empty(); };
+    void clear() override { m_adds.clear(); m_removes.clear(); };
+
+    void add(ECS::CommandTarget target, T comp) { m_adds.emplace_back(target, std::move(comp)); };
+    void remove(ECS::CommandTarget target) { m_removes.push_back(target); };
+
+private:
+    std::vector<std::pair<ECS::CommandTarget, T>> m_adds;
+    std::vector<ECS::CommandTarget> m_removes;
+};
+
+/*
+ * Records structural changes (create / add / remove / destroy) instead of applying them.
+ * A CommandBuffer belongs to exactly one thread, recording never locks.
+ * Get the buffer of the current thread from CommandBuffers::local().
+ */
+class alignas(64) CommandBuffer {
+public:
+    ECS::PendingEntity createEntity() { return ECS::PendingEntity{ m_createCount++ }; };
+
+    template<typename T>
+    void addComponent(Entity e, T c) { queue<T>().add(ECS::CommandTarget{ .entity = e }, std::move(c)); };
+
+    template<typename T>
+    void addComponent(ECS::PendingEntity e, T c) { queue<T>().add(ECS::CommandTarget{ .pending = e.index }, std::move(c)); };
+
+    template<typename T>
+    void removeComponent(Entity e) { queue<T>().remove(ECS::CommandTarget{ .entity = e }); };
+
+    void deleteEntity(Entity e) { m_deletes.push_back(e); };
+
+    [[nodiscard]] bool empty() const;
+    void clear();
+
+private:
+    friend class CommandBuffers;
+
+    template<typename T>
+    CommandQueue<T>& queue();
+
+    uint32_t m_createCount = 0;
+    std::vector<Entity> m_deletes;
+
+    // indexed by ECS::ComponentTypeID, like World's pool table
+    std::vector<std::unique_ptr<ICommandQueue>> m_queues;
+};
+
+/*
+ * One CommandBuffer per thread of a core::ThreadPool (index = ThreadPool::getWorkerIndex()).
+ * playback() applies everything at a sync point, in one pass per kind of command:
+ *   creates -> adds (type by type, sorted by entity) -> removes (same) -> destroys
+ * so a pool is reserved once per batch and its sparse pages are walked in order.
+ */
+class CommandBuffers {
+public:
+    // threadCount: ThreadPool::getConcurrency() of the pool recording into these buffers
+    explicit CommandBuffers(size_t threadCount) : m_buffers(threadCount) {};
+
+    // buffer of the calling thread
+    CommandBuffer& local();
+
+    // must not run while any thread is still recording
+    void playback(World& world);
+
+    [[nodiscard]] bool empty() const;
+
+private:
+    std::vector<CommandBuffer> m_buffers;
+};
+
+
+// Declarations
+template<typename T>
+void CommandQueue<T>::playbackAdds(World& world, const std::vector<CommandSource>& sources) {
+    size_t total = 0;
+    for (const auto& source : sources) {
+        total += static_cast<CommandQueue&>(*source.queue).m_adds.size();
+    }
+    if (total == 0) return;
+
+    std::vector<std::pair<Entity, T*>> batch;
+    batch.reserve(total);
+    for (const auto& source : sources) {
+        for (auto& [target, comp] : static_cast<CommandQueue&>(*source.queue).m_adds) {
+            batch.emplace_back(target.resolve(*source.created), &comp);
+        }
+    }
+
+    // stable: when one entity gets the same type twice the first recorded add wins, like World::addComponent
+    std::ranges::stable_sort(batch, {}, [](const auto& entry) { return ECS::getIndex(entry.first); });
+
+    auto& storage = world.getStorage<T>();
+    storage.reserve(storage.size() + batch.size());
+    for (auto& [e, comp] : batch) {
+        world.addComponent<T>(e, std::move(*comp));
+    }
+}
+
+template<typename T>
+void CommandQueue<T>::playbackRemoves(World& world, const std::vector<CommandSource>& sources) {
+    std::vector<Entity> batch;
+    for (const auto& source : sources) {
+        for (const auto& target : static_cast<CommandQueue&>(*source.queue).m_removes) {
+            batch.push_back(target.resolve(*source.created));
+        }
+    }
+    if (batch.empty()) return;
+
+    std::ranges::sort(batch, {}, ECS::getIndex);
+    for (const Entity e : batch) {
+        world.removeComponent<T>(e);
+    }
+}
+
+template<typename T>
+CommandQueue<T>& CommandBuffer::queue() {
+    const ECS::ComponentTypeID type = ECS::getComponentTypeID<T>();
+    if (type >= m_queues.size()) {
+        m_queues.resize(type + 1);
+    }
+    if (!m_queues[type]) {
+        m_queues[type] = std::make_unique<CommandQueue<T>>();
+    }
+    return static_cast<CommandQueue<T>&>(*m_queues[type]);
+}
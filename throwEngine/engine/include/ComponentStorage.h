@@ -2,19 +2,285 @@
 // Created by pointerlost on 8/6/25.
 //
 #pragma once
+#include <algorithm>
+#include <cstring>
 #include <iostream>
-#include <unordered_map>
+#include <limits>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
 #include "Entity.h"
+#include "core/Logger.h"
 
+// Type-erased pool interface, lets World destroy/merge entities without knowing their component types
+class IComponentStorage {
+public:
+    virtual ~IComponentStorage() = default;
+
+    virtual void remove(Entity e) = 0;
+    [[nodiscard]] virtual bool contains(Entity e) const = 0;
+    [[nodiscard]] virtual size_t size() const = 0;
+    [[nodiscard]] virtual const std::vector<Entity> &getEntities() const = 0;
+
+    // raw dense component array (size() elements of getComponentSize() bytes), used by WorldSnapshot
+    [[nodiscard]] virtual const void *getRawComponents() const = 0;
+    [[nodiscard]] virtual size_t getComponentSize() const = 0;
+    // replaces the pool content with count trivially copyable components, all added at tick
+    virtual bool loadRaw(const Entity *entities, const void *components, size_t count, uint32_t tick) = 0;
+
+    // new empty pool of the same component type
+    [[nodiscard]] virtual std::unique_ptr<IComponentStorage> createEmpty() const = 0;
+
+    // moves every component of other (same component type) into this pool,
+    // remap[slot index in other's world] = entity in this pool's world, merged components count as added at tick
+    virtual void mergeFrom(IComponentStorage& other, const std::vector<Entity>& remap, uint32_t tick) = 0;
+
+    // change tracking, 0 if e has no component here
+    [[nodiscard]] virtual uint32_t getAddedTick(Entity e) const = 0;
+    [[nodiscard]] virtual uint32_t getChangedTick(Entity e) const = 0;
+
+    // marks every component of the pool as added at tick
+    virtual void stampTicks(uint32_t tick) = 0;
+};
 
+/*
+ * Sparse-set storage:
+ *  - m_components : dense packed array of components (contiguous iteration)
+ *  - m_entities   : dense entity array, parallel to m_components
+ *  - m_sparse     : paged sparse index, entity slot index -> position in the dense arrays
+ *
+ * add / remove (swap-and-pop) / get are O(1) and never touch a hash table.
+ * Pages are only allocated for entity ranges that actually hold this component.
+ * The sparse index is keyed by the slot index only, lookups compare the full handle stored in
+ * m_entities so a stale generation never matches.
+ *
+ * Change tracking: two more dense arrays hold the World tick each component was added at and last
+ * changed at. Writes through a plain pointer/reference are not tracked, call markChanged() (or
+ * World::markChanged / World::patch) after modifying a component that consumers care about.
+ */
 template<typename T>
-class ComponentStorage {
+class ComponentStorage final : public IComponentStorage {
 public:
-    void add(Entity e, T comp);
-    void remove(Entity e);
+    static constexpr uint32_t PAGE_SIZE = 4096;
+    static constexpr uint32_t TOMBSTONE = std::numeric_limits<uint32_t>::max();
+
+    void add(Entity e, T comp, uint32_t tick);
+    void remove(Entity e) override;
     T *get(Entity e);
-    auto &getAll();
+    const T *get(Entity e) const;
+
+    [[nodiscard]] bool contains(Entity e) const override;
+    [[nodiscard]] size_t size() const override { return m_components.size(); };
+    [[nodiscard]] bool empty() const { return m_components.empty(); };
+
+    [[nodiscard]] std::unique_ptr<IComponentStorage> createEmpty() const override { return std::make_unique<ComponentStorage>(); };
+    void mergeFrom(IComponentStorage& other, const std::vector<Entity>& remap, uint32_t tick) override;
+
+    // only writes e's own tick slot, safe from parallel systems as long as each entity has one writer
+    void markChanged(Entity e, uint32_t tick);
+
+    [[nodiscard]] uint32_t getAddedTick(Entity e) const override;
+    [[nodiscard]] uint32_t getChangedTick(Entity e) const override;
+    void stampTicks(uint32_t tick) override;
+
+    // parallel to the dense arrays
+    const std::vector<uint32_t> &getAddedTicks() const { return m_addedTicks; };
+    const std::vector<uint32_t> &getChangedTicks() const { return m_changedTicks; };
+
+    void reserve(size_t capacity);
+    void clear();
+
+    // position of e in the dense arrays, TOMBSTONE if e has no component here
+    [[nodiscard]] uint32_t indexOf(Entity e) const { return denseIndex(e); };
+    // reorders two dense slots (used by owning groups to keep their members packed)
+    void swapDense(size_t a, size_t b);
+
+    // dense arrays, both in the same order (index i of one belongs to index i of the other)
+    std::vector<T> &getAll() { return m_components; };
+    const std::vector<T> &getAll() const { return m_components; };
+    const std::vector<Entity> &getEntities() const override { return m_entities; };
+
+    [[nodiscard]] const void *getRawComponents() const override { return m_components.data(); };
+    [[nodiscard]] size_t getComponentSize() const override { return sizeof(T); };
+    bool loadRaw(const Entity *entities, const void *components, size_t count, uint32_t tick) override;
 
 private:
-    std::unordered_map<Entity, T> components;
+    [[nodiscard]] uint32_t denseIndex(Entity e) const;
+    uint32_t &sparseSlot(Entity e);
+
+    std::vector<T> m_components;
+    std::vector<Entity> m_entities;
+    std::vector<uint32_t> m_addedTicks;
+    std::vector<uint32_t> m_changedTicks;
+    std::vector<std::vector<uint32_t>> m_sparse;
 };
+
+
+// Declarations
+template<typename T>
+void ComponentStorage<T>::add(Entity e, T comp, uint32_t tick) {
+    if (contains(e)) {
+        Logger::warn("Trying to add component that was already added");
+        return;
+    }
+    sparseSlot(e) = static_cast<uint32_t>(m_components.size());
+    m_components.push_back(std::move(comp));
+    m_entities.push_back(e);
+    m_addedTicks.push_back(tick);
+    m_changedTicks.push_back(tick);
+}
+
+template<typename T>
+void ComponentStorage<T>::remove(Entity e) {
+    const uint32_t index = denseIndex(e);
+    if (index == TOMBSTONE) return;
+
+    // move the last element into the hole, so the dense arrays stay packed
+    const uint32_t last = static_cast<uint32_t>(m_components.size() - 1);
+    if (index != last) {
+        m_components[index] = std::move(m_components[last]);
+        m_entities[index] = m_entities[last];
+        m_addedTicks[index] = m_addedTicks[last];
+        m_changedTicks[index] = m_changedTicks[last];
+        sparseSlot(m_entities[index]) = index;
+    }
+    m_components.pop_back();
+    m_entities.pop_back();
+    m_addedTicks.pop_back();
+    m_changedTicks.pop_back();
+    sparseSlot(e) = TOMBSTONE;
+}
+
+template<typename T>
+T *ComponentStorage<T>::get(Entity e) {
+    const uint32_t index = denseIndex(e);
+    return index == TOMBSTONE ? nullptr : &m_components[index];
+}
+
+template<typename T>
+const T *ComponentStorage<T>::get(Entity e) const {
+    const uint32_t index = denseIndex(e);
+    return index == TOMBSTONE ? nullptr : &m_components[index];
+}
+
+template<typename T>
+bool ComponentStorage<T>::contains(Entity e) const {
+    return denseIndex(e) != TOMBSTONE;
+}
+
+template<typename T>
+void ComponentStorage<T>::reserve(size_t capacity) {
+    m_components.reserve(capacity);
+    m_entities.reserve(capacity);
+    m_addedTicks.reserve(capacity);
+    m_changedTicks.reserve(capacity);
+}
+
+template<typename T>
+void ComponentStorage<T>::mergeFrom(IComponentStorage& other, const std::vector<Entity>& remap, uint32_t tick) {
+    auto& source = static_cast<ComponentStorage&>(other);
+
+    reserve(size() + source.size());
+    for (size_t i = 0; i < source.m_components.size(); ++i) {
+        // remapped entities are brand new in this world, so the contains() check of add() is skipped
+        const Entity e = remap[ECS::getIndex(source.m_entities[i])];
+        // not imported (World::merge rejects that up front), never let it take over sparse slot 0
+        if (e == ECS::NullEntity) continue;
+        sparseSlot(e) = static_cast<uint32_t>(m_components.size());
+        m_components.push_back(std::move(source.m_components[i]));
+        m_entities.push_back(e);
+    }
+    // ticks of the other world mean nothing here
+    m_addedTicks.resize(m_components.size(), tick);
+    m_changedTicks.resize(m_components.size(), tick);
+    source.clear();
+}
+
+template<typename T>
+bool ComponentStorage<T>::loadRaw(const Entity *entities, const void *components, size_t count, uint32_t tick) {
+    if constexpr (std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>) {
+        clear();
+        m_entities.assign(entities, entities + count);
+        m_components.resize(count);
+        std::memcpy(m_components.data(), components, count * sizeof(T));
+        m_addedTicks.assign(count, tick);
+        m_changedTicks.assign(count, tick);
+
+        for (uint32_t i = 0; i < count; ++i) {
+            sparseSlot(m_entities[i]) = i;
+        }
+        return true;
+    } else {
+        Logger::error("[ComponentStorage::loadRaw] component type is not trivially copyable");
+        return false;
+    }
+}
+
+template<typename T>
+void ComponentStorage<T>::markChanged(Entity e, uint32_t tick) {
+    const uint32_t index = denseIndex(e);
+    if (index != TOMBSTONE) m_changedTicks[index] = tick;
+}
+
+template<typename T>
+uint32_t ComponentStorage<T>::getAddedTick(Entity e) const {
+    const uint32_t index = denseIndex(e);
+    return index == TOMBSTONE ? 0 : m_addedTicks[index];
+}
+
+template<typename T>
+uint32_t ComponentStorage<T>::getChangedTick(Entity e) const {
+    const uint32_t index = denseIndex(e);
+    return index == TOMBSTONE ? 0 : m_changedTicks[index];
+}
+
+template<typename T>
+void ComponentStorage<T>::stampTicks(uint32_t tick) {
+    std::ranges::fill(m_addedTicks, tick);
+    std::ranges::fill(m_changedTicks, tick);
+}
+
+template<typename T>
+void ComponentStorage<T>::swapDense(size_t a, size_t b) {
+    if (a == b) return;
+    std::swap(m_components[a], m_components[b]);
+    std::swap(m_entities[a], m_entities[b]);
+    std::swap(m_addedTicks[a], m_addedTicks[b]);
+    std::swap(m_changedTicks[a], m_changedTicks[b]);
+    sparseSlot(m_entities[a]) = static_cast<uint32_t>(a);
+    sparseSlot(m_entities[b]) = static_cast<uint32_t>(b);
+}
+
+template<typename T>
+void ComponentStorage<T>::clear() {
+    m_components.clear();
+    m_entities.clear();
+    m_addedTicks.clear();
+    m_changedTicks.clear();
+    m_sparse.clear();
+}
+
+template<typename T>
+uint32_t ComponentStorage<T>::denseIndex(Entity e) const {
+    const uint32_t index = ECS::getIndex(e);
+    const size_t page = index / PAGE_SIZE;
+    if (page >= m_sparse.size() || m_sparse[page].empty()) {
+        return TOMBSTONE;
+    }
+    const uint32_t dense = m_sparse[page][index % PAGE_SIZE];
+    return dense != TOMBSTONE && m_entities[dense] == e ? dense : TOMBSTONE;
+}
+
+template<typename T>
+uint32_t &ComponentStorage<T>::sparseSlot(Entity e) {
+    const uint32_t index = ECS::getIndex(e);
+    const size_t page = index / PAGE_SIZE;
+    if (page >= m_sparse.size()) {
+        m_sparse.resize(page + 1);
+    }
+    if (m_sparse[page].empty()) {
+        m_sparse[page].assign(PAGE_SIZE, TOMBSTONE);
+    }
+    return m_sparse[page][index % PAGE_SIZE];
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <atomic>
+#include <bitset>
+#include <cstdint>
+#include <type_traits>
+
+/*
+ * Runtime component-type registry.
+ * Every component type gets a small sequential ID the first time it is used, which indexes the
+ * type-erased pool table in World and one bit of an entity's Signature.
+ * New component types need no registration code, using them is enough.
+ */
+namespace ECS
+{
+    constexpr size_t MAX_COMPONENT_TYPES = 64;
+
+    using ComponentTypeID = uint32_t;
+
+    // bit N set = entity has the component whose type ID is N
+    using Signature = std::bitset<MAX_COMPONENT_TYPES>;
+
+    namespace Detail
+    {
+        inline std::atomic<ComponentTypeID> g_nextComponentTypeID{ 0 };
+    }
+
+    template<typename T>
+    ComponentTypeID getComponentTypeID() {
+        // function-local static, initialized once (thread-safe) per component type
+        static const ComponentTypeID id = Detail::g_nextComponentTypeID.fetch_add(1, std::memory_order_relaxed);
+        return id;
+    }
+
+    template<typename... Ts>
+    Signature makeSignature() {
+        Signature signature;
+        (signature.set(getComponentTypeID<std::remove_const_t<Ts>>()), ...);
+        return signature;
+    }
+
+    // number of component types seen so far
+    inline ComponentTypeID getComponentTypeCount() {
+        return Detail::g_nextComponentTypeID.load(std::memory_order_relaxed);
+    }
+}
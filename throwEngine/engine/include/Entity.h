@@ -4,4 +4,28 @@
 #pragma once
 #include <iostream>
 
+/*
+ * Entity handle: low bits are the slot index, high bits are the generation of that slot.
+ * When an entity is destroyed its slot is recycled with generation + 1, so old handles stop
+ * matching instead of silently aliasing the new entity.
+ */
 using Entity = uint32_t;
+
+namespace ECS
+{
+    constexpr uint32_t ENTITY_INDEX_BITS      = 20; // ~1M live entities
+    constexpr uint32_t ENTITY_GENERATION_BITS = 12;
+
+    constexpr uint32_t ENTITY_INDEX_MASK      = (1u << ENTITY_INDEX_BITS) - 1;
+    constexpr uint32_t ENTITY_GENERATION_MASK = (1u << ENTITY_GENERATION_BITS) - 1;
+
+    // index 0 is never handed out, so a zero handle always means "no entity"
+    constexpr Entity NullEntity = 0;
+
+    constexpr uint32_t getIndex(const Entity e) { return e & ENTITY_INDEX_MASK; }
+    constexpr uint32_t getGeneration(const Entity e) { return e >> ENTITY_INDEX_BITS; }
+
+    constexpr Entity makeEntity(const uint32_t index, const uint32_t generation) {
+        return (index & ENTITY_INDEX_MASK) | ((generation & ENTITY_GENERATION_MASK) << ENTITY_INDEX_BITS);
+    }
+}
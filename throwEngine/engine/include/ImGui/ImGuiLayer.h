@@ -4,6 +4,7 @@
 #include <memory>
 #include <unordered_map>
 #include "ImGui/ImGuiObjectState.h"
+#include "Scene/SceneHandle.h"
 
 
 // forward declarations
@@ -37,19 +38,19 @@ namespace ENGINE::UI
 		bool imGuiImplementations(const std::shared_ptr<SCENE::Scene>& scene);
 
 		void setLightObjectProperties();
-		void implForRenderObjects(std::vector<std::shared_ptr<SCENE::SceneObject>>& sceneObjects);
+		void implForRenderObjects(SCENE::Scene& scene);
 
-		void sceneObjectSelectionPanel(const std::vector<std::shared_ptr<SCENE::SceneObject>>& sceneObjects);
+		void sceneObjectSelectionPanel(SCENE::Scene& scene);
 
 		void lightingPanelWindow();
 
-		void showMaterialProperties(std::shared_ptr<SCENE::SceneObject>& object, UIObjectState& state);
-		void showTransformProperties(std::shared_ptr<SCENE::SceneObject>& object, UIObjectState& state);
+		void showMaterialProperties(SCENE::SceneObject& object, UIObjectState& state);
+		void showTransformProperties(SCENE::SceneObject& object, UIObjectState& state);
 
-		void showSelectedObjectProperties(std::shared_ptr<SCENE::SceneObject>& object);
+		void showSelectedObjectProperties(SCENE::SceneObject& object, UIObjectState& state);
 
-		void setSceneObjectMaterial(const std::shared_ptr<SCENE::SceneObject>& sceneObject);
-		void setSceneObjectTransform(const std::shared_ptr<SCENE::SceneObject>& sceneObject);
+		void setSceneObjectMaterial(SCENE::SceneObject& sceneObject);
+		void setSceneObjectTransform(SCENE::SceneObject& sceneObject);
 
 		void generalMenuForPanel();
 
@@ -66,7 +67,8 @@ namespace ENGINE::UI
 
 		bool g_RequestShutdown = false;
 
-		std::unordered_map<std::string, UIObjectState> m_objectUIStates;
+		// per object window state, keyed by handle so the per-frame UI doesn't hash names
+		std::unordered_map<SCENE::SceneHandle, UIObjectState> m_objectUIStates;
 
 		bool m_showSceneEditorUI = false;
 		bool m_showObjectListWindow   = false;
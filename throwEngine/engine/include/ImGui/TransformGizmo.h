@@ -7,28 +7,26 @@
 #include <memory>
 #include <imgui.h>
 #include <ImGuizmo/ImGuizmo.h>
-
-namespace SCENE {
-    class SceneObject;
-}
+#include "Scene/SceneObject.h"
 
 namespace ENGINE::UI {
     class TransformGizmo {
     public:
-        void setTarget(const std::shared_ptr<SCENE::SceneObject>& obj) { m_sceneObject = obj; };
+        void setTarget(const SCENE::SceneObject& obj) { m_sceneObject = obj; };
 
         void setOperation(ImGuizmo::OPERATION op) { m_operation = op; };
 
-        void clear() { m_sceneObject.reset(); };
+        void clear() { m_sceneObject = {}; };
 
-        [[nodiscard]] bool hasTarget() const { return !m_sceneObject.expired(); };
+        // false once the target is destroyed, the handle goes stale with its entity
+        [[nodiscard]] bool hasTarget() const { return m_sceneObject.isValid(); };
 
-        [[nodiscard]] std::shared_ptr<SCENE::SceneObject> getTarget() const { return m_sceneObject.lock(); };
+        [[nodiscard]] SCENE::SceneObject getTarget() const { return m_sceneObject; };
 
         void update(const glm::mat4& view, const glm::mat4& projection, const ImVec2& viewportSize) const;
 
     private:
-        std::weak_ptr<SCENE::SceneObject> m_sceneObject;
+        SCENE::SceneObject m_sceneObject;
         ImGuizmo::OPERATION m_operation = ImGuizmo::TRANSLATE;
     };
 }
@@ -3,7 +3,7 @@
 #include <string>
 #include <memory>
 
-namespace Graphics { class Transform; };
+namespace SCENE { class SceneObject; };
 
 namespace LIGHTING {
 	class Light;
@@ -22,10 +22,10 @@ namespace Input
 		InputComponentFactory() = default;
 		~InputComponentFactory() = default;
 		
-		static std::shared_ptr<IInputComponent> createObjectComponent(InputType type, std::shared_ptr<Graphics::Transform> transform);
+		static std::shared_ptr<IInputComponent> createObjectComponent(InputType type, const SCENE::SceneObject& object);
 
 		static std::shared_ptr<IInputComponent> createLightComponent(InputType type,
-			std::shared_ptr<Graphics::Transform> transform,
+			const SCENE::SceneObject& object,
 			std::shared_ptr<LIGHTING::Light>& light);
 	};
 } // namespace Input
\ No newline at end of file
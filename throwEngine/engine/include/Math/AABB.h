@@ -0,0 +1,80 @@
+#pragma once
+#include <algorithm>
+#include <limits>
+#include <glm/glm.hpp>
+
+namespace MATH {
+
+    // axis-aligned box, a default constructed one is empty (min > max) and grows with expand()/merge()
+    struct AABB {
+        glm::vec3 min{ std::numeric_limits<float>::max() };
+        glm::vec3 max{ std::numeric_limits<float>::lowest() };
+
+        [[nodiscard]] bool isValid() const { return min.x <= max.x && min.y <= max.y && min.z <= max.z; };
+
+        [[nodiscard]] glm::vec3 getCenter() const { return (min + max) * 0.5f; };
+        [[nodiscard]] glm::vec3 getExtents() const { return (max - min) * 0.5f; };
+
+        // the SAH cost measure
+        [[nodiscard]] float getSurfaceArea() const {
+            const glm::vec3 d = max - min;
+            return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+        };
+
+        void expand(const glm::vec3& point) {
+            min = glm::min(min, point);
+            max = glm::max(max, point);
+        };
+
+        [[nodiscard]] AABB fattened(float margin) const { return { min - glm::vec3(margin), max + glm::vec3(margin) }; };
+
+        [[nodiscard]] bool contains(const AABB& other) const {
+            return min.x <= other.min.x && min.y <= other.min.y && min.z <= other.min.z &&
+                   max.x >= other.max.x && max.y >= other.max.y && max.z >= other.max.z;
+        };
+
+        [[nodiscard]] bool overlaps(const AABB& other) const {
+            return min.x <= other.max.x && max.x >= other.min.x &&
+                   min.y <= other.max.y && max.y >= other.min.y &&
+                   min.z <= other.max.z && max.z >= other.min.z;
+        };
+
+        // 0 inside the box
+        [[nodiscard]] float distanceSquared(const glm::vec3& point) const {
+            const glm::vec3 d = glm::max(glm::max(min - point, point - max), glm::vec3(0.0f));
+            return glm::dot(d, d);
+        };
+    };
+
+    [[nodiscard]] inline AABB merge(const AABB& a, const AABB& b) {
+        return { glm::min(a.min, b.min), glm::max(a.max, b.max) };
+    }
+
+    // bounds of the transformed box (Arvo): center moves with the matrix, extents through |M|
+    [[nodiscard]] inline AABB transformAABB(const AABB& box, const glm::mat4& m) {
+        const glm::vec3 center = glm::vec3(m * glm::vec4(box.getCenter(), 1.0f));
+        const glm::vec3 e = box.getExtents();
+        const glm::vec3 extents = glm::abs(glm::vec3(m[0])) * e.x + glm::abs(glm::vec3(m[1])) * e.y + glm::abs(glm::vec3(m[2])) * e.z;
+        return { center - extents, center + extents };
+    }
+
+    /*
+     * Slab test against a ray given as origin and 1/direction (precomputed once per ray, a zero component
+     * gives +-inf). True if the ray enters the box within [0, maxT], tEnter is 0 when the origin is inside.
+     * Unlike Math::RayIntersectsAABB, boxes behind the origin are rejected.
+     */
+    [[nodiscard]] inline bool rayIntersectsAABB(const glm::vec3& origin, const glm::vec3& invDir, float maxT,
+                                                const AABB& box, float& tEnter) {
+        const glm::vec3 t0 = (box.min - origin) * invDir;
+        const glm::vec3 t1 = (box.max - origin) * invDir;
+        const glm::vec3 tNear = glm::min(t0, t1);
+        const glm::vec3 tFar = glm::max(t0, t1);
+
+        const float enter = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+        const float exit = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, maxT));
+        if (enter > exit) return false;
+
+        tEnter = enter;
+        return true;
+    }
+}
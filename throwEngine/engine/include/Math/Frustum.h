@@ -0,0 +1,36 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+#include "Math/AABB.h"
+
+namespace MATH {
+
+    /*
+     * View frustum as 6 planes (left, right, bottom, top, near, far) with normals pointing inside,
+     * a point p is inside a plane when dot(normal, p) + d >= 0. Planes are normalized, so that value
+     * is a distance in world units.
+     */
+    struct Frustum {
+        // xyz = normal, w = d
+        std::array<glm::vec4, 6> planes{};
+
+        // Gribb/Hartmann extraction from projection * view, OpenGL clip space (z in [-w, w])
+        [[nodiscard]] static Frustum fromViewProjection(const glm::mat4& viewProjection);
+
+        // conservative: false only if the box is completely outside one plane
+        [[nodiscard]] bool intersects(const AABB& box) const;
+    };
+
+    /*
+     * Batched frustum test over boxes given as SoA center/extents arrays, MATH::SIMD::Lanes::WIDTH boxes
+     * per instruction. visible[i] = 1 if box i intersects the frustum, 0 if not (same test as intersects).
+     * Returns how many boxes are visible. Arrays need no alignment or padding, the tail is scalar.
+     */
+    size_t cullAABBs(const Frustum& frustum,
+                     const float* centerX, const float* centerY, const float* centerZ,
+                     const float* extentX, const float* extentY, const float* extentZ,
+                     size_t count, uint8_t* visible);
+}
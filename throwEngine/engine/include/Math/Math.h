@@ -2,9 +2,13 @@
 // Created by pointerlost on 8/7/25.
 //
 #pragma once
+#include <cstddef>
 #include <glm/vec3.hpp>
 
 namespace MATH {
 
     glm::vec3 wrapAngles(glm::vec3 angles);
+
+    // wrapAngles over a plain float array (e.g. one SoA column), in place, SIMD
+    void wrapAnglesBulk(float* angles, size_t count);
 }
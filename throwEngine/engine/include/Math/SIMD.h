@@ -0,0 +1,102 @@
+#pragma once
+#include <cmath>
+#include <cstddef>
+
+#if defined(__AVX__)
+    #include <immintrin.h>
+    #define THROW_SIMD_AVX 1
+    #define THROW_SIMD_NAMESPACE avx
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #include <emmintrin.h>
+    #define THROW_SIMD_SSE 1
+    #define THROW_SIMD_NAMESPACE sse2
+#else
+    #define THROW_SIMD_NAMESPACE scalar
+#endif
+
+namespace MATH::SIMD {
+
+    /*
+     * Float lanes of the widest instruction set the engine is compiled for:
+     * 8 with AVX, 4 with SSE2 (every x86-64 build), 1 elsewhere. THROW_ENABLE_AVX only builds the
+     * kernel translation units with AVX, so Lanes lives in a per instruction set inline namespace:
+     * translation units built with and without AVX get distinct types instead of ODR-clashing ones.
+     * Loads/stores are unaligned, batched kernels just step through SoA arrays WIDTH floats at a time.
+     * Comparisons return a lane mask (all bits set where true), combined with | and read with mask().
+     */
+    inline namespace THROW_SIMD_NAMESPACE {
+#if defined(THROW_SIMD_AVX)
+    struct Lanes {
+        static constexpr size_t WIDTH = 8;
+        __m256 v;
+
+        static Lanes load(const float* p) { return { _mm256_loadu_ps(p) }; };
+        static Lanes set(float f) { return { _mm256_set1_ps(f) }; };
+        void store(float* p) const { _mm256_storeu_ps(p, v); };
+
+        friend Lanes operator+(Lanes a, Lanes b) { return { _mm256_add_ps(a.v, b.v) }; };
+        friend Lanes operator-(Lanes a, Lanes b) { return { _mm256_sub_ps(a.v, b.v) }; };
+        friend Lanes operator*(Lanes a, Lanes b) { return { _mm256_mul_ps(a.v, b.v) }; };
+        friend Lanes operator/(Lanes a, Lanes b) { return { _mm256_div_ps(a.v, b.v) }; };
+        friend Lanes floor(Lanes a) { return { _mm256_floor_ps(a.v) }; };
+
+        friend Lanes lessThan(Lanes a, Lanes b) { return { _mm256_cmp_ps(a.v, b.v, _CMP_LT_OQ) }; };
+        friend Lanes operator|(Lanes a, Lanes b) { return { _mm256_or_ps(a.v, b.v) }; };
+        // bit i set = lane i of a comparison is true
+        [[nodiscard]] int mask() const { return _mm256_movemask_ps(v); };
+    };
+#elif defined(THROW_SIMD_SSE)
+    struct Lanes {
+        static constexpr size_t WIDTH = 4;
+        __m128 v;
+
+        static Lanes load(const float* p) { return { _mm_loadu_ps(p) }; };
+        static Lanes set(float f) { return { _mm_set1_ps(f) }; };
+        void store(float* p) const { _mm_storeu_ps(p, v); };
+
+        friend Lanes operator+(Lanes a, Lanes b) { return { _mm_add_ps(a.v, b.v) }; };
+        friend Lanes operator-(Lanes a, Lanes b) { return { _mm_sub_ps(a.v, b.v) }; };
+        friend Lanes operator*(Lanes a, Lanes b) { return { _mm_mul_ps(a.v, b.v) }; };
+        friend Lanes operator/(Lanes a, Lanes b) { return { _mm_div_ps(a.v, b.v) }; };
+        // SSE2 has no floor: truncate, then step down where truncation rounded a negative value up
+        friend Lanes floor(Lanes a) {
+            const __m128 truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(a.v));
+            const __m128 roundedUp = _mm_and_ps(_mm_cmpgt_ps(truncated, a.v), _mm_set1_ps(1.0f));
+            return { _mm_sub_ps(truncated, roundedUp) };
+        };
+
+        friend Lanes lessThan(Lanes a, Lanes b) { return { _mm_cmplt_ps(a.v, b.v) }; };
+        friend Lanes operator|(Lanes a, Lanes b) { return { _mm_or_ps(a.v, b.v) }; };
+        // bit i set = lane i of a comparison is true
+        [[nodiscard]] int mask() const { return _mm_movemask_ps(v); };
+    };
+#else
+    struct Lanes {
+        static constexpr size_t WIDTH = 1;
+        float v;
+
+        static Lanes load(const float* p) { return { *p }; };
+        static Lanes set(float f) { return { f }; };
+        void store(float* p) const { *p = v; };
+
+        friend Lanes operator+(Lanes a, Lanes b) { return { a.v + b.v }; };
+        friend Lanes operator-(Lanes a, Lanes b) { return { a.v - b.v }; };
+        friend Lanes operator*(Lanes a, Lanes b) { return { a.v * b.v }; };
+        friend Lanes operator/(Lanes a, Lanes b) { return { a.v / b.v }; };
+        friend Lanes floor(Lanes a) { return { std::floor(a.v) }; };
+
+        // a scalar mask is -1 (true) or 0 (false), mask() reads its sign like movemask does
+        friend Lanes lessThan(Lanes a, Lanes b) { return { a.v < b.v ? -1.0f : 0.0f }; };
+        friend Lanes operator|(Lanes a, Lanes b) { return { std::signbit(a.v) || std::signbit(b.v) ? -1.0f : 0.0f }; };
+        [[nodiscard]] int mask() const { return std::signbit(v) ? 1 : 0; };
+    };
+#endif
+    }
+
+    // lane count the engine's batched kernels were built with, may be wider than the caller's Lanes::WIDTH
+    [[nodiscard]] size_t kernelWidth();
+
+    // false if the kernels were built for an instruction set this CPU lacks (THROW_ENABLE_AVX on a CPU
+    // without AVX), nothing that may run them can start then
+    [[nodiscard]] bool kernelsSupported();
+}
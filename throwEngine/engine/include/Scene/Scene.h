@@ -1,48 +1,75 @@
 #pragma once
 #include <iostream>
-#include <stack>
+#include <limits>
+#include <span>
+#include <type_traits>
 #include <vector>
 #include "glm/ext.hpp"
 #include "Input/InputContext.h"
 #include <unordered_map>
 #include "graphics/Grid/GridSystem.h"
+#include "Scene/SceneComponents.h"
+#include "Scene/SceneHandle.h"
+#include "Scene/SceneObject.h"
+#include "Spatial/DynamicBVH.h"
+#include "Spatial/SpatialHashGrid.h"
+#include "World.h"
 
 namespace Graphics
 {
 	class RenderData;
 	class MeshData3D;
+	class TransformPool;
+	struct SubMeshInfo;
 };
 
-namespace LIGHTING
-{
-	class Light;
-	class LightData;
-	class LightManager;
-}
-
 namespace SHADER
 {
-	class ShaderManager;
+	class IShader;
 }
 
 namespace Graphics
 {
-	class MaterialLibrary;
 	struct Material;
 }
 
-namespace Input { class IInputComponent; };
-
 namespace SCENE
 {
 	// Forward declarations
-	class SceneObject;
 	class SceneObjectFactory;
 
+	// everything a new scene object starts with
+	struct SceneObjectDesc
+	{
+		// optional, only named objects can be found with getObjectWithNameFromMap
+		core::NameId name;
+		// sub-mesh of the scene's MeshData3D ("cube", "sphere", ...)
+		std::string subMeshName;
+		std::shared_ptr<Graphics::Material> material;
+		// null = the ECS render path's default (basic_instanced)
+		std::shared_ptr<SHADER::IShader> shader;
+
+		glm::vec3 position{ 0.0f };
+		glm::vec3 eulerAngles{ 0.0f };
+		glm::vec3 scale{ 1.0f };
+
+		// Dynamic for objects that move every frame (lights, projectiles), see SpatialProxyComponent
+		Mobility mobility = Mobility::Static;
+	};
+
+	/*
+	 * Facade over World entities. A scene object is an entity with NameComponent, TransformComponent,
+	 * MeshComponent and MaterialComponent (plus InputHandlerComponent when it has input), drawn by
+	 * Render::MeshRenderSystem. Objects are identified by SceneHandle, names are an optional secondary index.
+	 * The scene adds that index, end-of-frame deletion and spatial queries over world bounds on top: static
+	 * objects are in a DynamicBVH, dynamic ones in a SpatialHashGrid, every query runs on both.
+	 * The World is shared with the engine's systems, the scene does not own it.
+	 */
 	class Scene
 	{
 	public:
-		Scene(const std::shared_ptr<Graphics::MeshData3D> &data3D, Input::InputContext context);
+		Scene(World& world, const std::shared_ptr<Graphics::TransformPool>& transformPool,
+			const std::shared_ptr<Graphics::MeshData3D>& data3D, Input::InputContext context);
 
 		void setSceneObjectFactoryPointer(SceneObjectFactory* factory) { sceneObjectFactory = factory; };
 		[[nodiscard]] SceneObjectFactory* getSceneObjectFactory() const { return sceneObjectFactory; };
@@ -50,53 +77,144 @@ namespace SCENE
 		void initGrid(const std::shared_ptr<Graphics::RenderData>& renderData) const;
 		void setOwnershipGridSystemToScene(std::unique_ptr<GRID::GridSystem>& gridSystem) { m_gridSystem = std::move(gridSystem); };
 
-		void debugDrawing(const glm::mat4& view, const glm::mat4& projection, const std::shared_ptr<Graphics::RenderData>& renderData);
-		void drawGrid(const glm::mat4& view, const glm::mat4& projection, const std::shared_ptr<Graphics::RenderData>& renderData);
-		void drawAllObjects(const glm::mat4& view, const glm::mat4& projection, const std::shared_ptr<Graphics::RenderData>& renderData);
+		// camera matrices come from the FrameData block the Renderer uploads each frame
+		void drawGrid(const std::shared_ptr<Graphics::RenderData>& renderData);
 
-		[[nodiscard]] std::vector<std::shared_ptr<SceneObject>>& getSceneObjectVec() { return m_sceneObjectsVec; };
-		[[nodiscard]] const std::shared_ptr<SceneObject>& getObjectWithNameFromMap(const std::string &name) const;
+		[[nodiscard]] World& getWorld() { return m_world; };
+		[[nodiscard]] const std::shared_ptr<Graphics::TransformPool>& getTransformPool() const { return m_transformPool; };
 
-		void updateInputComponents();
+		// false once the object is destroyed, also for the null handle
+		[[nodiscard]] bool isAlive(SceneHandle handle) const;
+		// invalid SceneObject if the handle is stale
+		[[nodiscard]] SceneObject getObject(SceneHandle handle);
+		// invalid SceneObject if there is no object with that name
+		[[nodiscard]] SceneObject getObjectWithNameFromMap(core::NameId name);
+		// looks the string up without interning it
+		[[nodiscard]] SceneObject getObjectWithNameFromMap(const std::string& name);
+		[[nodiscard]] size_t getObjectCount() const { return m_objectCount; };
+
+		// func(SceneObject) for every object, objects must not be created or destroyed from func
+		template<typename Func>
+		void forEachObject(Func&& func);
 
-		[[nodiscard]] uint32_t uniqueObjectIDGenerator();
+		void updateInputComponents();
 
-		void createObjectProperties(const std::shared_ptr<SceneObject>& sceneObject);
-		void markToBeDeleted(const std::string& name);
+		// inserts new objects into their spatial structure and moves the ones whose world matrix changed
+		// this frame, once per frame after the transforms are updated
+		void updateSpatialIndex();
+		// moves the object to the other structure right away, no-op if it already has that mobility
+		void setMobility(SceneHandle handle, Mobility mobility);
+
+		// closest object whose world bounds the ray hits within maxDistance (in direction's units), null handle if none
+		[[nodiscard]] SceneHandle pick(const glm::vec3& origin, const glm::vec3& direction,
+			float maxDistance = std::numeric_limits<float>::max()) const;
+		// object whose world bounds are closest to point, null handle if none is within maxDistance
+		[[nodiscard]] SceneHandle findNearest(const glm::vec3& point, float maxDistance = std::numeric_limits<float>::max()) const;
+		// func(SceneHandle) for every object whose world bounds overlap box, return false from func to stop
+		template<typename Func>
+		void queryOverlap(const MATH::AABB& box, Func&& func) const;
+		// func(SceneHandle) for every object whose world bounds are within radius of center
+		template<typename Func>
+		void querySphere(const glm::vec3& center, float radius, Func&& func) const;
+		// func(SceneHandle) for every object whose world bounds intersect the frustum
+		template<typename Func>
+		void queryFrustum(const MATH::Frustum& frustum, Func&& func) const;
+
+		[[nodiscard]] const SPATIAL::DynamicBVH& getBVH() const { return m_bvh; };
+		[[nodiscard]] const SPATIAL::SpatialHashGrid& getGrid() const { return m_grid; };
+
+		// null handle (and a warning) if the name is already taken
+		SceneHandle createObjectProperties(const SceneObjectDesc& desc);
+		// one object per position, everything else from prototype. Bulk objects are unnamed (prototype.name
+		// is ignored), containers are grown once for the batch and the sub-mesh is looked up once
+		std::vector<SceneHandle> createObjects(const SceneObjectDesc& prototype, std::span<const glm::vec3> positions);
+		void markToBeDeleted(SceneHandle handle);
+		void markToBeDeleted(core::NameId name);
+		// destroys everything marked since the last call, once per frame after drawing
 		void cleanUp();
-		void destroyObject(const std::string& name);
+		void destroyObject(SceneHandle handle);
+		void destroyObject(core::NameId name);
 
 	private:
+		// entity with every scene object component, desc.name is not indexed here
+		Entity addObject(const SceneObjectDesc& desc, const glm::vec3& position, const Graphics::SubMeshInfo* subMesh);
+		void destroyEntity(Entity entity);
+
+		// adapts func(SceneHandle) (returning void or bool) to the structures' func(userData) -> continue
+		template<typename Func>
+		static auto handleCallback(Func& func, bool& keepGoing);
+
+		World& m_world;
+		std::shared_ptr<Graphics::TransformPool> m_transformPool;
+
 		std::shared_ptr<Graphics::MeshData3D> meshData3D;
 
 		Input::InputContext inputContext;
 
 		std::unique_ptr<GRID::GridSystem> m_gridSystem;
 
-		std::vector<std::shared_ptr<Input::IInputComponent>> m_inputComponents;
-
 		SceneObjectFactory* sceneObjectFactory = nullptr;
 
-		/************************************************************/
+		// name -> entity of named objects only, nothing per frame goes through it
+		std::unordered_map<core::NameId, Entity> m_nameIndex;
 
-		/*  This Scene object addition and deletion system written higher performance */
+		size_t m_objectCount = 0;
 
-		// Maps unique object IDs to their shared_ptr for fast access
-		std::unordered_map<uint32_t, std::shared_ptr<SceneObject>> m_sceneObjectsMap;
+		// keep items that need to be deleted until the end of the frame (to avoid crashes)
+		std::vector<Entity> m_markForDeletion;
 
-		// Maps object names to their index in the scene vector
-		std::unordered_map<std::string, uint32_t> m_nameIndexHash;
+		// reused by updateInputComponents
+		std::vector<std::shared_ptr<Input::IInputComponent>> m_inputQueue;
 
-		// Stores all scene objects, Some entries might be nullptr after deletion, so check before use.
-		std::vector<std::shared_ptr<SceneObject>> m_sceneObjectsVec;
+		// world bounds of every object with a mesh by mobility, proxy user data is the object's entity
+		SPATIAL::DynamicBVH m_bvh;
+		SPATIAL::SpatialHashGrid m_grid;
+	};
 
-		// Stack of available (free) indices in the vector - for reusing slots
-		std::stack<uint32_t> m_freeIndicesStack;
 
-		// to use free IDs store in the stack
-		std::stack<uint32_t> m_freeIDs;
+	// Declarations
+	template<typename Func>
+	void Scene::forEachObject(Func&& func)
+	{
+		m_world.view<NameComponent>().each([&](Entity entity, NameComponent&) {
+			func(SceneObject(this, entity));
+		});
+	}
 
-		// keep items that need to be deleted until the end of the frame (to avoid crashes)
-		std::stack<std::string> m_markForDeletion;
-	};
-}
\ No newline at end of file
+	template<typename Func>
+	auto Scene::handleCallback(Func& func, bool& keepGoing)
+	{
+		return [&func, &keepGoing](uint32_t entity) {
+			if constexpr (std::is_void_v<std::invoke_result_t<Func&, SceneHandle>>) {
+				func(SceneHandle::fromEntity(entity));
+			} else {
+				keepGoing = static_cast<bool>(func(SceneHandle::fromEntity(entity)));
+			}
+			return keepGoing;
+		};
+	}
+
+	template<typename Func>
+	void Scene::queryOverlap(const MATH::AABB& box, Func&& func) const
+	{
+		bool keepGoing = true;
+		m_bvh.queryOverlap(box, handleCallback(func, keepGoing));
+		if (keepGoing) m_grid.queryOverlap(box, handleCallback(func, keepGoing));
+	}
+
+	template<typename Func>
+	void Scene::querySphere(const glm::vec3& center, float radius, Func&& func) const
+	{
+		bool keepGoing = true;
+		m_bvh.querySphere(center, radius, handleCallback(func, keepGoing));
+		if (keepGoing) m_grid.querySphere(center, radius, handleCallback(func, keepGoing));
+	}
+
+	template<typename Func>
+	void Scene::queryFrustum(const MATH::Frustum& frustum, Func&& func) const
+	{
+		bool keepGoing = true;
+		m_bvh.queryFrustum(frustum, handleCallback(func, keepGoing));
+		if (keepGoing) m_grid.queryFrustum(frustum, handleCallback(func, keepGoing));
+	}
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include <memory>
+#include <cstdint>
+#include "core/NameId.h"
+#include "Spatial/DynamicBVH.h"
+#include "Spatial/SpatialHashGrid.h"
+
+namespace Input { class IInputComponent; };
+
+// Components that only scene objects carry, next to TransformComponent, MeshComponent and MaterialComponent.
+
+// every scene object has one (invalid id for unnamed objects), it is also what tells scene entities apart
+// from other World entities
+struct NameComponent {
+    core::NameId name;
+};
+
+// objects driven by an input behaviour (lights, player controlled shapes), most objects have none
+struct InputHandlerComponent {
+    std::shared_ptr<Input::IInputComponent> input;
+};
+
+// which spatial structure of the scene holds the object
+enum class Mobility : uint8_t {
+    // rarely moves: DynamicBVH, best queries, a move outside the fat box costs a reinsert
+    Static,
+    // moves every frame: SpatialHashGrid, O(1) moves, slightly slower queries
+    Dynamic,
+};
+
+// the object's proxy in the structure picked by mobility, null until Scene::updateSpatialIndex first sees its world bounds
+struct SpatialProxyComponent {
+    static_assert(SPATIAL::DynamicBVH::NULL_NODE == SPATIAL::SpatialHashGrid::NULL_PROXY);
+    static constexpr uint32_t NULL_PROXY = SPATIAL::DynamicBVH::NULL_NODE;
+
+    uint32_t proxy = NULL_PROXY;
+    Mobility mobility = Mobility::Static;
+};
@@ -0,0 +1,33 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include "Entity.h"
+
+namespace SCENE
+{
+	/*
+	 * Stable id of a scene object, what subsystems (LightManager, ImGuiLayer, ...) store instead of its name.
+	 * It is the object's entity split into slot index and generation: when the object is destroyed the
+	 * slot is recycled with a new generation, so an old handle never aliases the object created after it.
+	 * Comparing and hashing a handle is a couple of integer ops, no string is touched.
+	 */
+	struct SceneHandle
+	{
+		uint32_t index = 0;
+		uint32_t generation = 0;
+
+		[[nodiscard]] static constexpr SceneHandle fromEntity(Entity entity) { return { ECS::getIndex(entity), ECS::getGeneration(entity) }; };
+		[[nodiscard]] constexpr Entity toEntity() const { return ECS::makeEntity(index, generation); };
+
+		// index 0 is never handed out (ECS::NullEntity)
+		[[nodiscard]] constexpr bool isNull() const { return index == 0; };
+
+		constexpr bool operator==(const SceneHandle& other) const = default;
+	};
+}
+
+template<>
+struct std::hash<SCENE::SceneHandle>
+{
+	size_t operator()(const SCENE::SceneHandle& handle) const noexcept { return std::hash<uint32_t>{}(handle.toEntity()); }
+};
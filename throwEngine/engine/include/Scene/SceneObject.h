@@ -1,93 +1,87 @@
 #pragma once
 #include <glm/ext.hpp>
 #include <memory>
-
-namespace Graphics
-{
-	class RenderData;
-	class IMesh;
-	class Transform;
-}
+#include <string>
+#include "Entity.h"
+#include "core/NameId.h"
+#include "Scene/SceneHandle.h"
 
 namespace SHADER
 {
-	class ShaderManager;
 	class IShader;
-	class Shader;
 };
 
 namespace Graphics
 {
-	class MaterialLibrary;
 	struct Material;
 };
 
 namespace Input { class IInputComponent; };
 
-namespace LIGHTING
-{
-	class Light;
-	struct LightColor;
-	enum struct LightMobility;
-};
+// Scene/SceneComponents.h
+enum class Mobility : uint8_t;
 
 namespace SCENE
 {
 	class Scene;
 
+	/*
+	 * Handle to a scene object. The object itself is a World entity, its data lives in the component
+	 * pools (NameComponent, TransformComponent, MeshComponent, MaterialComponent, InputHandlerComponent)
+	 * and the transform in the TransformPool. A handle is just {scene, entity}, copy it freely.
+	 * Once the object is destroyed the handle is invalid, only isValid() may be called on it then.
+	 */
 	class SceneObject
 	{
 	public:
-		SceneObject(std::shared_ptr<Graphics::IMesh> mesh, std::string  materialName);
-		virtual ~SceneObject() = default;
-
-		[[nodiscard]] bool validateRenderState(const std::shared_ptr<Graphics::RenderData>& renderData);
-
-		void initializeMaterial(const std::shared_ptr<Graphics::MaterialLibrary>& library);
+		SceneObject() = default;
+		SceneObject(Scene* scene, Entity entity) : m_scene(scene), m_entity(entity) {};
+		SceneObject(Scene* scene, SceneHandle handle) : m_scene(scene), m_entity(handle.toEntity()) {};
+
+		[[nodiscard]] bool isValid() const;
+		explicit operator bool() const { return isValid(); };
+
+		[[nodiscard]] Entity getEntity() const { return m_entity; };
+		// what other subsystems should keep instead of the name
+		[[nodiscard]] SceneHandle getHandle() const { return SceneHandle::fromEntity(m_entity); };
+		// invalid for unnamed objects, compare these rather than getName()
+		[[nodiscard]] core::NameId getNameId() const;
+		// empty for unnamed objects
+		[[nodiscard]] const std::string& getName() const { return getNameId().str(); };
+
+		// objects share their library material until they are edited
+		[[nodiscard]] std::shared_ptr<Graphics::Material> getMaterialInstance() const;
+		// the object's own copy of its material, made on first call, safe to modify
+		[[nodiscard]] std::shared_ptr<Graphics::Material> getEditableMaterial();
 		void setMaterialInstance(std::shared_ptr<Graphics::Material> instance);
-		[[nodiscard]] std::shared_ptr<Graphics::Material> getMaterialInstance() const { return m_materialInstance; };
-		[[nodiscard]] std::string getMaterialName() const { return m_materialName; };
 
 		void setShaderInterface(std::shared_ptr<SHADER::IShader> shader);
-		[[nodiscard]] std::shared_ptr<SHADER::IShader> getShaderInterface() const { return m_shaderInterface; };
-
-		void draw(const glm::mat4& view, const glm::mat4& projection, const std::shared_ptr<Graphics::RenderData>& renderData);
+		[[nodiscard]] std::shared_ptr<SHADER::IShader> getShaderInterface() const;
 
-		void setID(const uint32_t id) { m_objectID = id;   };
-		[[nodiscard]] uint32_t getID() const  { return m_objectID; };
+		void setInputComponent(const std::shared_ptr<Input::IInputComponent>& inputComponent);
+		[[nodiscard]] std::shared_ptr<Input::IInputComponent> getInputComponent() const;
 
-		void setName(const std::string& name) { this->m_objectName = name; };
-		[[nodiscard]] const std::string& getName() const { return m_objectName; };
+		[[nodiscard]] uint32_t getTransformID() const;
+		[[nodiscard]] glm::vec3 getPosition() const;
+		[[nodiscard]] glm::vec3 getEulerAngles() const;
+		[[nodiscard]] glm::vec3 getScale() const;
+		void setPosition(const glm::vec3& position);
+		void setRotation(const glm::vec3& eulerAngles);
+		void setScale(const glm::vec3& scale);
+		// world matrix as of the last TransformPool::updateMatrices()
+		[[nodiscard]] const glm::mat4& getModelMatrix() const;
 
-		void setInputComponent(const std::shared_ptr<Input::IInputComponent>& inputComponent) { m_inputComponent = inputComponent; };
+		// which spatial structure of the scene holds the object, see Scene::setMobility
+		[[nodiscard]] Mobility getMobility() const;
+		void setMobility(Mobility mobility);
 
-		[[nodiscard]] std::shared_ptr<Input::IInputComponent> getInputComponent() const { return m_inputComponent; };
+		// destroyed at the end of the frame (Scene::cleanUp)
+		void markForDeletion();
 
-		[[nodiscard]] std::shared_ptr<Graphics::Transform>& getTransform() { return m_transform; };
-
-		void markForDeletion() { m_markedForDeletion = true; };
-		[[nodiscard]] bool isMarkedForDeletion() const { return m_markedForDeletion; };
+		bool operator==(const SceneObject& other) const = default;
 
 	private:
-
-		void prepareShader(const glm::mat4& model, const glm::mat4& view, const glm::mat4& projection,
-			const glm::vec3& cameraPos, const std::shared_ptr<Graphics::RenderData>& renderData) const;
-
-		void bindMaterialAndTextures(const std::shared_ptr<Graphics::RenderData>& renderData) const;
-
-		std::shared_ptr<Graphics::IMesh> m_mesh;
-		std::shared_ptr<Graphics::Transform> m_transform;
-
-		std::shared_ptr<Input::IInputComponent> m_inputComponent = nullptr;
-		std::shared_ptr<SHADER::IShader> m_shaderInterface = nullptr;
-
-		std::string m_objectName;
-		std::string m_materialName;
-
-		std::shared_ptr<Graphics::Material> m_materialInstance;
-
-		bool m_markedForDeletion = false;
-
-		uint32_t m_objectID = -1;
+		Scene* m_scene = nullptr;
+		Entity m_entity = ECS::NullEntity;
 	};
 }
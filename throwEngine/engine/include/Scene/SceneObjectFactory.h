@@ -1,12 +1,16 @@
 #pragma once
 #include <string>
 #include <memory>
+#include <span>
+#include <vector>
 #include <glm/ext.hpp>
 
 #include <Input/InputContext.h>
 
 #include "graphics/Lighting/Light.h"
 #include "graphics/Renderer/RenderData.h"
+#include "Scene/SceneComponents.h"
+#include "Scene/SceneObject.h"
 
 namespace SHADER
 {
@@ -29,7 +33,6 @@ namespace Graphics { class MaterialLibrary; };
 namespace SCENE
 {
 	class Scene;
-	class SceneObject;
 
 	class SceneObjectFactory
 	{
@@ -39,9 +42,16 @@ namespace SCENE
 
 		[[nodiscard]] std::shared_ptr<Graphics::MeshData3D> getMeshData() const;
 
-		[[nodiscard]] std::shared_ptr<SceneObject> createCube(const glm::vec3& pos = glm::vec3(0.0), const std::string& materialName = "leather", bool visualLightObj = false) const;
+		// invalid SceneObject if the scene isn't set
+		SceneObject createCube(const glm::vec3& pos = glm::vec3(0.0), const std::string& materialName = "leather") const;
 
-		[[nodiscard]] std::shared_ptr<SceneObject> createSphere(const glm::vec3& pos = glm::vec3(0.0), const std::string& materialName = "gold", bool visualLightObj = false) const;
+		SceneObject createSphere(const glm::vec3& pos = glm::vec3(0.0), const std::string& materialName = "gold") const;
+
+		// one unnamed object per position, material and shader are looked up once for the whole batch.
+		// Empty if the scene isn't set
+		std::vector<SceneHandle> createCubes(std::span<const glm::vec3> positions, const std::string& materialName = "leather") const;
+
+		std::vector<SceneHandle> createSpheres(std::span<const glm::vec3> positions, const std::string& materialName = "gold") const;
 
 		[[nodiscard]] bool createPointLight(const std::string& materialName = "gold",
 			const glm::vec3& position = glm::vec3(7.0)) const;
@@ -61,7 +71,8 @@ namespace SCENE
 			return inputContext;
 		};
 
-		static std::string generateName(const std::string& type);
+		// "<type>_<n>", n counts per type
+		static core::NameId generateName(const std::string& type);
 
 		void setScene(const std::shared_ptr<Scene>& scene) { m_scene = scene; };
 		std::shared_ptr<Scene>& getScene() { return m_scene; };
@@ -75,5 +86,17 @@ namespace SCENE
 		std::shared_ptr<SCENE::Scene> m_scene;
 		
 		void initBaseMeshes() const;
+
+		SceneObject createShape(const std::string& subMeshName, core::NameId name, const glm::vec3& pos,
+			const glm::vec3& scale, const std::string& materialName, Mobility mobility = Mobility::Static) const;
+
+		std::vector<SceneHandle> createShapes(const std::string& subMeshName, std::span<const glm::vec3> positions,
+			const glm::vec3& scale, const std::string& materialName) const;
+
+		// shared library material, the default material (and a warning) if there is none with that name
+		std::shared_ptr<Graphics::Material> getMaterialOrDefault(const std::string& materialName) const;
+
+		bool createLight(LIGHTING::LightType type, const std::string& typeName, const std::string& materialName,
+			const glm::vec3& position) const;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,228 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "Math/AABB.h"
+#include "Math/Frustum.h"
+
+namespace SPATIAL {
+
+    // result of a closest-hit or nearest query, userData is whatever the proxy was created with
+    struct QueryHit {
+        uint32_t userData = 0;
+        // ray parameter of the hit, or squared distance for nearest()
+        float distance = std::numeric_limits<float>::max();
+        bool hit = false;
+    };
+
+    /*
+     * Dynamic AABB tree (bounding volume hierarchy) over proxies, one leaf per proxy.
+     *
+     * Leaves store the proxy's tight box and a "fat" box enlarged by a margin. moveProxy() is free while
+     * the new tight box stays inside the fat one, otherwise the leaf is removed and reinserted.
+     * Insertion descends to the sibling with the lowest surface area cost (SAH), then walks back up
+     * refitting boxes and applying tree rotations that lower the cost, so the tree stays good under
+     * incremental updates without ever being rebuilt.
+     *
+     * Queries descend only into nodes whose box passes the test, O(log n) for selective queries.
+     * Proxy ids are stable node indices, freed nodes are recycled. Not thread-safe for writes,
+     * const queries may run concurrently.
+     */
+    class DynamicBVH {
+    public:
+        static constexpr uint32_t NULL_NODE = std::numeric_limits<uint32_t>::max();
+
+        // margin added on every side of a leaf's fat box (world units)
+        explicit DynamicBVH(float margin = 0.5f) : m_margin(margin) {};
+
+        uint32_t createProxy(const MATH::AABB& box, uint32_t userData);
+        void destroyProxy(uint32_t proxy);
+        // true if the proxy had to be reinserted, false if its fat box still contains box
+        bool moveProxy(uint32_t proxy, const MATH::AABB& box);
+
+        [[nodiscard]] uint32_t getUserData(uint32_t proxy) const { return m_nodes[proxy].userData; };
+        [[nodiscard]] const MATH::AABB& getAABB(uint32_t proxy) const { return m_nodes[proxy].tight; };
+        [[nodiscard]] const MATH::AABB& getFatAABB(uint32_t proxy) const { return m_nodes[proxy].box; };
+
+        [[nodiscard]] size_t getProxyCount() const { return m_proxyCount; };
+        // 0 for an empty tree or a single leaf
+        [[nodiscard]] uint32_t getHeight() const { return m_root == NULL_NODE ? 0 : m_nodes[m_root].height; };
+        // sum of internal node surface areas over the root's, lower is a better tree
+        [[nodiscard]] float computeCost() const;
+
+        void clear();
+
+        // func(userData) for every proxy whose tight box overlaps box, return false from func to stop
+        template<typename Func>
+        void queryOverlap(const MATH::AABB& box, Func&& func) const;
+
+        // func(userData) for every proxy whose tight box is within radius of center, return false from func to stop
+        template<typename Func>
+        void querySphere(const glm::vec3& center, float radius, Func&& func) const;
+
+        // func(userData) for every proxy whose tight box intersects the frustum, return false from func to stop
+        template<typename Func>
+        void queryFrustum(const MATH::Frustum& frustum, Func&& func) const;
+
+        // func(userData, tEnter) for every proxy whose tight box is hit within [0, maxT] (not in order).
+        // func returns the new maxT: maxT to keep going, tEnter to clip to this hit, 0 to stop
+        template<typename Func>
+        void raycast(const glm::vec3& origin, const glm::vec3& direction, float maxT, Func&& func) const;
+
+        // closest tight box along the ray, direction doesn't have to be normalized (distance is in its units)
+        [[nodiscard]] QueryHit raycastClosest(const glm::vec3& origin, const glm::vec3& direction,
+                                              float maxT = std::numeric_limits<float>::max()) const;
+
+        // proxy whose tight box is closest to point (0 inside), within maxDistance
+        [[nodiscard]] QueryHit nearest(const glm::vec3& point, float maxDistance = std::numeric_limits<float>::max()) const;
+
+    private:
+        struct Node {
+            // fat box for leaves, union of the children for internal nodes
+            MATH::AABB box;
+            // leaves only
+            MATH::AABB tight;
+            // next free node while in the free list
+            uint32_t parent = NULL_NODE;
+            uint32_t child1 = NULL_NODE;
+            uint32_t child2 = NULL_NODE;
+            uint32_t userData = 0;
+            // leaf = 0
+            uint32_t height = 0;
+
+            [[nodiscard]] bool isLeaf() const { return child1 == NULL_NODE; };
+        };
+
+        // fixed stack for traversal, spills to the heap only for very deep trees
+        class NodeStack {
+        public:
+            void push(uint32_t node) {
+                if (m_size < m_inline.size()) m_inline[m_size] = node;
+                else m_spill.push_back(node);
+                ++m_size;
+            };
+            uint32_t pop() {
+                --m_size;
+                if (m_size < m_inline.size()) return m_inline[m_size];
+                const uint32_t node = m_spill.back();
+                m_spill.pop_back();
+                return node;
+            };
+            [[nodiscard]] bool empty() const { return m_size == 0; };
+
+        private:
+            std::array<uint32_t, 64> m_inline{};
+            std::vector<uint32_t> m_spill;
+            size_t m_size = 0;
+        };
+
+        uint32_t allocateNode();
+        void freeNode(uint32_t node);
+
+        void insertLeaf(uint32_t leaf);
+        void removeLeaf(uint32_t leaf);
+        uint32_t findBestSibling(const MATH::AABB& box) const;
+        // refits boxes and heights from node up to the root, rotating where it lowers the cost
+        void refitAncestors(uint32_t node, bool rotate);
+        void rotate(uint32_t node);
+
+        std::vector<Node> m_nodes;
+        uint32_t m_root = NULL_NODE;
+        uint32_t m_freeList = NULL_NODE;
+        size_t m_proxyCount = 0;
+        float m_margin;
+    };
+
+
+    // Declarations
+    template<typename Func>
+    void DynamicBVH::queryOverlap(const MATH::AABB &box, Func &&func) const {
+        if (m_root == NULL_NODE) return;
+
+        NodeStack stack;
+        stack.push(m_root);
+        while (!stack.empty()) {
+            const Node& node = m_nodes[stack.pop()];
+            if (!node.box.overlaps(box)) continue;
+
+            if (node.isLeaf()) {
+                if (node.tight.overlaps(box) && !func(node.userData)) return;
+            } else {
+                stack.push(node.child1);
+                stack.push(node.child2);
+            }
+        }
+    }
+
+    template<typename Func>
+    void DynamicBVH::querySphere(const glm::vec3 &center, float radius, Func &&func) const {
+        if (m_root == NULL_NODE) return;
+
+        const float radiusSquared = radius * radius;
+
+        NodeStack stack;
+        stack.push(m_root);
+        while (!stack.empty()) {
+            const Node& node = m_nodes[stack.pop()];
+            if (node.box.distanceSquared(center) > radiusSquared) continue;
+
+            if (node.isLeaf()) {
+                if (node.tight.distanceSquared(center) <= radiusSquared && !func(node.userData)) return;
+            } else {
+                stack.push(node.child1);
+                stack.push(node.child2);
+            }
+        }
+    }
+
+    template<typename Func>
+    void DynamicBVH::queryFrustum(const MATH::Frustum &frustum, Func &&func) const {
+        if (m_root == NULL_NODE) return;
+
+        NodeStack stack;
+        stack.push(m_root);
+        while (!stack.empty()) {
+            const Node& node = m_nodes[stack.pop()];
+            if (!frustum.intersects(node.box)) continue;
+
+            if (node.isLeaf()) {
+                if (frustum.intersects(node.tight) && !func(node.userData)) return;
+            } else {
+                stack.push(node.child1);
+                stack.push(node.child2);
+            }
+        }
+    }
+
+    template<typename Func>
+    void DynamicBVH::raycast(const glm::vec3 &origin, const glm::vec3 &direction, float maxT, Func &&func) const {
+        if (m_root == NULL_NODE) return;
+
+        const glm::vec3 invDir = 1.0f / direction;
+
+        NodeStack stack;
+        stack.push(m_root);
+        while (!stack.empty()) {
+            const Node& node = m_nodes[stack.pop()];
+
+            float tEnter;
+            if (!MATH::rayIntersectsAABB(origin, invDir, maxT, node.box, tEnter)) continue;
+
+            if (node.isLeaf()) {
+                if (!MATH::rayIntersectsAABB(origin, invDir, maxT, node.tight, tEnter)) continue;
+                maxT = func(node.userData, tEnter);
+                if (maxT <= 0.0f) return;
+            } else {
+                // the nearer child is popped first, so closest-hit queries clip maxT early
+                const Node& a = m_nodes[node.child1];
+                const Node& b = m_nodes[node.child2];
+                const bool firstIsNearer = glm::dot(a.box.getCenter() - b.box.getCenter(), direction) < 0.0f;
+                stack.push(firstIsNearer ? node.child2 : node.child1);
+                stack.push(firstIsNearer ? node.child1 : node.child2);
+            }
+        }
+    }
+}
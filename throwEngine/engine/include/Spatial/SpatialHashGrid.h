@@ -0,0 +1,331 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "Math/AABB.h"
+#include "Math/Frustum.h"
+#include "Spatial/DynamicBVH.h"
+
+namespace SPATIAL {
+
+    /*
+     * Loose hashed uniform grid for proxies that move every frame, the counterpart of DynamicBVH with
+     * the same query interface (queryOverlap, querySphere, queryFrustum, raycast, raycastClosest, nearest).
+     *
+     * A proxy lives in exactly one cell, the one containing its center. Cells are "loose": their
+     * contents stay within the cell grown by half a cell on every side, so a query only looks at the
+     * cells whose loose box passes the test. moveProxy() is O(1): the box is overwritten, and when the
+     * center crosses into another cell the proxy is swap-removed from the old cell's list and appended
+     * to the new one. Nothing is ever rebalanced.
+     * Proxies bigger than a cell go to an overflow list that every query tests directly, keep cellSize
+     * above the typical object size.
+     *
+     * Only occupied cells exist (hash map from packed cell coordinates). A query walks the cells of its
+     * range, or every occupied cell when that is cheaper (huge ranges, frustums), so its cost is bounded
+     * by the number of occupied cells and not by the size of the world. Rays step through the cells
+     * they cross (3D DDA), front to back.
+     * Proxy ids are stable and recycled. Not thread-safe for writes, const queries may run concurrently.
+     */
+    class SpatialHashGrid {
+    public:
+        static constexpr uint32_t NULL_PROXY = std::numeric_limits<uint32_t>::max();
+
+        explicit SpatialHashGrid(float cellSize = 8.0f) : m_cellSize(cellSize), m_inverseCellSize(1.0f / cellSize) {};
+
+        uint32_t createProxy(const MATH::AABB& box, uint32_t userData);
+        void destroyProxy(uint32_t proxy);
+        // true if the proxy changed cell
+        bool moveProxy(uint32_t proxy, const MATH::AABB& box);
+
+        [[nodiscard]] uint32_t getUserData(uint32_t proxy) const { return m_proxies[proxy].userData; };
+        [[nodiscard]] const MATH::AABB& getAABB(uint32_t proxy) const { return m_proxies[proxy].box; };
+
+        [[nodiscard]] size_t getProxyCount() const { return m_proxyCount; };
+        [[nodiscard]] size_t getCellCount() const { return m_cellIndex.size(); };
+        [[nodiscard]] float getCellSize() const { return m_cellSize; };
+
+        void clear();
+
+        // func(userData) for every proxy whose box overlaps box, return false from func to stop
+        template<typename Func>
+        void queryOverlap(const MATH::AABB& box, Func&& func) const;
+
+        // func(userData) for every proxy whose box is within radius of center, return false from func to stop
+        template<typename Func>
+        void querySphere(const glm::vec3& center, float radius, Func&& func) const;
+
+        // func(userData) for every proxy whose box intersects the frustum, return false from func to stop
+        template<typename Func>
+        void queryFrustum(const MATH::Frustum& frustum, Func&& func) const;
+
+        // same contract as DynamicBVH::raycast: func(userData, tEnter) returns the new maxT, 0 stops
+        template<typename Func>
+        void raycast(const glm::vec3& origin, const glm::vec3& direction, float maxT, Func&& func) const;
+
+        [[nodiscard]] QueryHit raycastClosest(const glm::vec3& origin, const glm::vec3& direction,
+                                              float maxT = std::numeric_limits<float>::max()) const;
+
+        // searches rings of cells outward from the point's cell, stops once the next ring can't beat the best hit
+        [[nodiscard]] QueryHit nearest(const glm::vec3& point, float maxDistance = std::numeric_limits<float>::max()) const;
+
+    private:
+        // marks proxies of the overflow list in Proxy::cell
+        static constexpr uint32_t OVERFLOW_CELL = NULL_PROXY - 1;
+
+        struct Proxy {
+            MATH::AABB box;
+            uint32_t userData = 0;
+            // index into m_cells, OVERFLOW_CELL, or NULL_PROXY while free
+            uint32_t cell = NULL_PROXY;
+            // position in the cell's (or overflow) list, next free proxy while free
+            uint32_t slot = NULL_PROXY;
+        };
+
+        struct Cell {
+            glm::ivec3 coords{ 0 };
+            std::vector<uint32_t> proxies;
+        };
+
+        [[nodiscard]] glm::ivec3 cellCoords(const glm::vec3& point) const {
+            return { static_cast<int>(std::floor(point.x * m_inverseCellSize)),
+                     static_cast<int>(std::floor(point.y * m_inverseCellSize)),
+                     static_cast<int>(std::floor(point.z * m_inverseCellSize)) };
+        };
+        // 21 bits per axis, distant cells may share a key, that only costs extra box tests
+        [[nodiscard]] static uint64_t cellKey(const glm::ivec3& coords) {
+            constexpr uint64_t mask = (1u << 21) - 1;
+            return (static_cast<uint64_t>(coords.x) & mask) | (static_cast<uint64_t>(coords.y) & mask) << 21 |
+                   (static_cast<uint64_t>(coords.z) & mask) << 42;
+        };
+        // the cell grown by half a cell, every proxy of the cell is inside it
+        [[nodiscard]] MATH::AABB looseBounds(const Cell& cell) const {
+            const glm::vec3 min = glm::vec3(cell.coords) * m_cellSize - glm::vec3(m_cellSize * 0.5f);
+            return { min, min + glm::vec3(m_cellSize * 2.0f) };
+        };
+        [[nodiscard]] bool fitsCell(const MATH::AABB& box) const {
+            const glm::vec3 size = box.max - box.min;
+            return size.x <= m_cellSize && size.y <= m_cellSize && size.z <= m_cellSize;
+        };
+
+        void link(uint32_t proxy);
+        void unlink(uint32_t proxy);
+
+        // func(cell) for every occupied cell whose loose box may overlap box (looked up by range or walked)
+        template<typename Func>
+        void forEachCell(const MATH::AABB& box, Func&& func) const;
+
+        float m_cellSize;
+        float m_inverseCellSize;
+
+        std::vector<Proxy> m_proxies;
+        uint32_t m_freeProxy = NULL_PROXY;
+        size_t m_proxyCount = 0;
+
+        // packed coords -> index into m_cells. Emptied cells go to m_freeCells and keep their list capacity
+        std::unordered_map<uint64_t, uint32_t> m_cellIndex;
+        std::vector<Cell> m_cells;
+        std::vector<uint32_t> m_freeCells;
+        // occupied cells, what a whole-grid walk iterates
+        std::vector<uint32_t> m_occupied;
+        // every cell ever occupied is in [m_minCell, m_maxCell], only grows until clear(). Clips rays
+        glm::ivec3 m_minCell{ std::numeric_limits<int>::max() };
+        glm::ivec3 m_maxCell{ std::numeric_limits<int>::min() };
+        // position of each cell in m_occupied
+        std::vector<uint32_t> m_occupiedSlot;
+
+        std::vector<uint32_t> m_overflow;
+    };
+
+
+    // Declarations
+    template<typename Func>
+    void SpatialHashGrid::forEachCell(const MATH::AABB &box, Func &&func) const {
+        if (m_occupied.empty() || !box.isValid()) return;
+
+        // a cell holds proxies centered in it, so a proxy overlapping box is centered at most half a cell outside it.
+        // The range is computed in double first, huge boxes would overflow int cell coordinates
+        const glm::vec3 half(m_cellSize * 0.5f);
+        const auto cellOf = [this](float f) { return std::floor(static_cast<double>(f) * m_inverseCellSize); };
+        const glm::vec3 lo = box.min - half;
+        const glm::vec3 hi = box.max + half;
+        const double rangeCells = (cellOf(hi.x) - cellOf(lo.x) + 1) * (cellOf(hi.y) - cellOf(lo.y) + 1) *
+                                  (cellOf(hi.z) - cellOf(lo.z) + 1);
+        constexpr double COORD_LIMIT = 1 << 30;
+        const bool outOfRange = std::abs(cellOf(lo.x)) > COORD_LIMIT || std::abs(cellOf(lo.y)) > COORD_LIMIT ||
+                                std::abs(cellOf(lo.z)) > COORD_LIMIT || std::abs(cellOf(hi.x)) > COORD_LIMIT ||
+                                std::abs(cellOf(hi.y)) > COORD_LIMIT || std::abs(cellOf(hi.z)) > COORD_LIMIT;
+
+        if (outOfRange || rangeCells > static_cast<double>(m_occupied.size())) {
+            for (const uint32_t cellIndex : m_occupied) {
+                const Cell& cell = m_cells[cellIndex];
+                if (looseBounds(cell).overlaps(box) && !func(cell)) return;
+            }
+            return;
+        }
+
+        const glm::ivec3 first = cellCoords(lo);
+        const glm::ivec3 last = cellCoords(hi);
+        for (int z = first.z; z <= last.z; ++z) {
+            for (int y = first.y; y <= last.y; ++y) {
+                for (int x = first.x; x <= last.x; ++x) {
+                    const auto it = m_cellIndex.find(cellKey({ x, y, z }));
+                    if (it == m_cellIndex.end()) continue;
+
+                    // a key collision brings in a distant cell, skip it
+                    const Cell& cell = m_cells[it->second];
+                    if (cell.coords != glm::ivec3(x, y, z)) continue;
+                    if (!func(cell)) return;
+                }
+            }
+        }
+    }
+
+    template<typename Func>
+    void SpatialHashGrid::queryOverlap(const MATH::AABB &box, Func &&func) const {
+        bool keepGoing = true;
+        forEachCell(box, [&](const Cell& cell) {
+            for (const uint32_t proxy : cell.proxies) {
+                const Proxy& p = m_proxies[proxy];
+                if (p.box.overlaps(box) && !func(p.userData)) return keepGoing = false;
+            }
+            return true;
+        });
+        if (!keepGoing) return;
+
+        for (const uint32_t proxy : m_overflow) {
+            const Proxy& p = m_proxies[proxy];
+            if (p.box.overlaps(box) && !func(p.userData)) return;
+        }
+    }
+
+    template<typename Func>
+    void SpatialHashGrid::querySphere(const glm::vec3 &center, float radius, Func &&func) const {
+        const float radiusSquared = radius * radius;
+
+        bool keepGoing = true;
+        forEachCell(MATH::AABB{ center - glm::vec3(radius), center + glm::vec3(radius) }, [&](const Cell& cell) {
+            for (const uint32_t proxy : cell.proxies) {
+                const Proxy& p = m_proxies[proxy];
+                if (p.box.distanceSquared(center) <= radiusSquared && !func(p.userData)) return keepGoing = false;
+            }
+            return true;
+        });
+        if (!keepGoing) return;
+
+        for (const uint32_t proxy : m_overflow) {
+            const Proxy& p = m_proxies[proxy];
+            if (p.box.distanceSquared(center) <= radiusSquared && !func(p.userData)) return;
+        }
+    }
+
+    template<typename Func>
+    void SpatialHashGrid::queryFrustum(const MATH::Frustum &frustum, Func &&func) const {
+        for (const uint32_t cellIndex : m_occupied) {
+            const Cell& cell = m_cells[cellIndex];
+            if (!frustum.intersects(looseBounds(cell))) continue;
+
+            for (const uint32_t proxy : cell.proxies) {
+                const Proxy& p = m_proxies[proxy];
+                if (frustum.intersects(p.box) && !func(p.userData)) return;
+            }
+        }
+        for (const uint32_t proxy : m_overflow) {
+            const Proxy& p = m_proxies[proxy];
+            if (frustum.intersects(p.box) && !func(p.userData)) return;
+        }
+    }
+
+    template<typename Func>
+    void SpatialHashGrid::raycast(const glm::vec3 &origin, const glm::vec3 &direction, float maxT, Func &&func) const {
+        const glm::vec3 invDir = 1.0f / direction;
+
+        bool keepGoing = true;
+        const auto testProxy = [&](uint32_t proxy) {
+            const Proxy& p = m_proxies[proxy];
+            float tEnter;
+            if (!MATH::rayIntersectsAABB(origin, invDir, maxT, p.box, tEnter)) return true;
+            maxT = func(p.userData, tEnter);
+            return keepGoing = maxT > 0.0f;
+        };
+
+        for (const uint32_t proxy : m_overflow) {
+            if (!testProxy(proxy)) return;
+        }
+        if (m_occupied.empty()) return;
+
+        // clip the ray to everywhere a cell has been, padded by a cell for the loose margin
+        const MATH::AABB region{ glm::vec3(m_minCell - glm::ivec3(1)) * m_cellSize, glm::vec3(m_maxCell + glm::ivec3(2)) * m_cellSize };
+        float tStart;
+        if (!MATH::rayIntersectsAABB(origin, invDir, maxT, region, tStart)) return;
+        const glm::vec3 tRegion = glm::max((region.min - origin) * invDir, (region.max - origin) * invDir);
+        const float tEnd = std::min(std::min(tRegion.x, tRegion.y), std::min(tRegion.z, maxT));
+
+        // a DDA step looks up ~9 cells, short of walking every occupied cell for very long rays in sparse grids
+        const float steps = (tEnd - tStart) * glm::length(direction) * m_inverseCellSize * 3.0f;
+        if (steps * 9.0f > static_cast<float>(m_occupied.size())) {
+            for (const uint32_t cellIndex : m_occupied) {
+                const Cell& cell = m_cells[cellIndex];
+                float tCell;
+                if (!MATH::rayIntersectsAABB(origin, invDir, maxT, looseBounds(cell), tCell)) continue;
+                for (const uint32_t proxy : cell.proxies) {
+                    if (!testProxy(proxy)) return;
+                }
+            }
+            return;
+        }
+
+        /*
+         * 3D DDA over the cells the ray passes, front to back. A proxy hit at t lies in the loose box of its
+         * cell, so its cell is a neighbour of the cell containing the ray at t: every visited cell looks at
+         * its 3x3x3 neighbourhood. Neighbourhoods of consecutive cells overlap, a cell already covered by
+         * the previous step is skipped (the ray crosses a neighbourhood in one contiguous run of steps).
+         */
+        glm::ivec3 cell = glm::clamp(cellCoords(origin + direction * tStart), m_minCell - glm::ivec3(1), m_maxCell + glm::ivec3(1));
+        glm::ivec3 step{ 0 };
+        glm::vec3 tNext{ std::numeric_limits<float>::max() };
+        glm::vec3 tDelta{ std::numeric_limits<float>::max() };
+        for (int axis = 0; axis < 3; ++axis) {
+            if (direction[axis] > 0.0f) {
+                step[axis] = 1;
+                tNext[axis] = (static_cast<float>(cell[axis] + 1) * m_cellSize - origin[axis]) * invDir[axis];
+            } else if (direction[axis] < 0.0f) {
+                step[axis] = -1;
+                tNext[axis] = (static_cast<float>(cell[axis]) * m_cellSize - origin[axis]) * invDir[axis];
+            } else {
+                continue;
+            }
+            tDelta[axis] = m_cellSize * std::abs(invDir[axis]);
+        }
+
+        glm::ivec3 previous = cell;
+        bool first = true;
+        for (float tCell = tStart; tCell <= maxT && tCell <= tEnd;) {
+            for (int z = -1; z <= 1; ++z) {
+                for (int y = -1; y <= 1; ++y) {
+                    for (int x = -1; x <= 1; ++x) {
+                        const glm::ivec3 coords = cell + glm::ivec3(x, y, z);
+                        const glm::ivec3 fromPrevious = glm::abs(coords - previous);
+                        if (!first && fromPrevious.x <= 1 && fromPrevious.y <= 1 && fromPrevious.z <= 1) continue;
+
+                        const auto it = m_cellIndex.find(cellKey(coords));
+                        if (it == m_cellIndex.end() || m_cells[it->second].coords != coords) continue;
+                        for (const uint32_t proxy : m_cells[it->second].proxies) {
+                            if (!testProxy(proxy)) return;
+                        }
+                    }
+                }
+            }
+            previous = cell;
+            first = false;
+
+            const int axis = tNext.x < tNext.y ? (tNext.x < tNext.z ? 0 : 2) : (tNext.y < tNext.z ? 1 : 2);
+            tCell = tNext[axis];
+            cell[axis] += step[axis];
+            tNext[axis] += tDelta[axis];
+        }
+    }
+}
@@ -0,0 +1,153 @@
+#pragma once
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "CommandBuffer.h"
+#include "ComponentType.h"
+#include "View.h"
+#include "World.h"
+#include "core/ThreadPool.h"
+
+// handed to every system update, gives access to the worker pool for intra-system parallelism
+class SystemContext {
+public:
+    static constexpr size_t DEFAULT_CHUNK_SIZE = 1024;
+
+    SystemContext(core::ThreadPool& pool, CommandBuffers& commands, float deltaTime, uint32_t tick, uint32_t lastRunTick)
+        : m_pool(pool), m_commands(commands), m_deltaTime(deltaTime), m_tick(tick), m_lastRunTick(lastRunTick) {};
+
+    // view.each(func) split in chunks over the pool, func must only touch the entity it was given
+    template<typename... Ts, typename Func>
+    void parallelEach(const View<Ts...>& view, Func&& func, size_t chunkSize = DEFAULT_CHUNK_SIZE);
+
+    // command buffer of the calling thread, structural changes recorded here are applied after the frame
+    [[nodiscard]] CommandBuffer& getCommands() const { return m_commands.local(); };
+
+    [[nodiscard]] core::ThreadPool& getThreadPool() const { return m_pool; };
+    [[nodiscard]] float getDeltaTime() const { return m_deltaTime; };
+
+    // tick of this system run, pass it to World::markChanged(e, tick) for components this system modifies
+    [[nodiscard]] uint32_t getTick() const { return m_tick; };
+    // tick of the previous run of this system (0 before the first one), for view.filter<ECS::Changed<T>>(...)
+    [[nodiscard]] uint32_t getLastRunTick() const { return m_lastRunTick; };
+
+private:
+    core::ThreadPool& m_pool;
+    CommandBuffers& m_commands;
+    float m_deltaTime;
+    uint32_t m_tick;
+    uint32_t m_lastRunTick;
+};
+
+/*
+ * Runs registered systems once per frame.
+ * Every system declares the component types it reads and writes. Each frame the scheduler builds a
+ * dependency graph from those declarations: a system depends on every earlier-registered system it
+ * conflicts with (write/write or read/write on the same type), everything else runs concurrently on
+ * the thread pool. Registration order is the execution order of conflicting systems.
+ *
+ *   scheduler.addSystem("Movement")
+ *       .reads<VelocityComponent>()
+ *       .writes<TransformComponent>()
+ *       .run([](World& world, SystemContext& ctx) { ... });
+ *
+ * Systems touching OpenGL/GLFW must be marked onMainThread(). Structural changes (create/delete
+ * entities, add/remove components) go through ctx.getCommands() and are played back in one batch
+ * once every system of the frame finished, systems calling World directly must be marked exclusive().
+ *
+ * Every system gets its own World tick per frame, in registration order, so a system filtering on
+ * ECS::Changed<T> since its last run sees each change of a conflicting system exactly once.
+ */
+class SystemScheduler {
+public:
+    using UpdateFunc = std::function<void(World&, SystemContext&)>;
+
+private:
+    struct System {
+        std::string name;
+        ECS::Signature reads;
+        ECS::Signature writes;
+        bool mainThreadOnly = false;
+        bool exclusive = false;
+        UpdateFunc update;
+        uint32_t lastRunTick = 0;
+
+        // creates the pools of the declared types, so no pool is created while systems run in parallel
+        std::vector<std::function<void(World&)>> preparePools;
+    };
+
+public:
+    class SystemBuilder;
+
+    explicit SystemScheduler(core::ThreadPool& pool) : m_pool(pool), m_commands(pool.getConcurrency()) {};
+
+    SystemBuilder addSystem(const std::string& name);
+
+    // runs every system once, then plays back the recorded commands, returns after all of it finished
+    void run(World& world, float deltaTime);
+
+    [[nodiscard]] size_t getSystemCount() const { return m_systems.size(); };
+
+    class SystemBuilder {
+    public:
+        SystemBuilder(SystemScheduler& scheduler, size_t index) : m_scheduler(scheduler), m_index(index) {};
+
+        template<typename... Ts>
+        SystemBuilder& reads();
+        template<typename... Ts>
+        SystemBuilder& writes();
+
+        SystemBuilder& onMainThread() { system().mainThreadOnly = true; return *this; };
+        SystemBuilder& exclusive() { system().exclusive = true; return *this; };
+
+        SystemBuilder& run(UpdateFunc update) { system().update = std::move(update); return *this; };
+
+    private:
+        System& system() { return m_scheduler.m_systems[m_index]; };
+
+        SystemScheduler& m_scheduler;
+        size_t m_index;
+    };
+
+private:
+    struct FrameState;
+
+    [[nodiscard]] static bool conflicts(const System& a, const System& b);
+    void buildGraph();
+    void launch(FrameState& frame, size_t index);
+    void execute(FrameState& frame, size_t index);
+
+    core::ThreadPool& m_pool;
+    CommandBuffers m_commands;
+    std::vector<System> m_systems;
+
+    // rebuilt every frame by buildGraph()
+    std::vector<std::vector<size_t>> m_dependents;
+    std::vector<uint32_t> m_dependencyCounts;
+};
+
+
+// Declarations
+template<typename... Ts, typename Func>
+void SystemContext::parallelEach(const View<Ts...>& view, Func&& func, size_t chunkSize) {
+    m_pool.parallelFor(view.sizeHint(), chunkSize, [&view, &func](size_t begin, size_t end) {
+        view.each(begin, end, func);
+    });
+}
+
+template<typename... Ts>
+SystemScheduler::SystemBuilder& SystemScheduler::SystemBuilder::reads() {
+    system().reads |= ECS::makeSignature<Ts...>();
+    system().preparePools.emplace_back([](World& world) { (static_cast<void>(world.getStorage<std::remove_const_t<Ts>>()), ...); });
+    return *this;
+}
+
+template<typename... Ts>
+SystemScheduler::SystemBuilder& SystemScheduler::SystemBuilder::writes() {
+    system().writes |= ECS::makeSignature<Ts...>();
+    system().preparePools.emplace_back([](World& world) { (static_cast<void>(world.getStorage<std::remove_const_t<Ts>>()), ...); });
+    return *this;
+}
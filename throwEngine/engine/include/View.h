@@ -0,0 +1,364 @@
+#pragma once
+#include <array>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "ComponentStorage.h"
+#include "ComponentType.h"
+#include "Entity.h"
+
+namespace ECS {
+    // view filters, see View::filter
+    template<typename T>
+    struct Changed {};
+
+    template<typename T>
+    struct Added {};
+
+    template<typename F>
+    struct FilterTraits;
+
+    template<typename T>
+    struct FilterTraits<Changed<T>> {
+        using Component = std::remove_const_t<T>;
+        static constexpr bool ADDED = false;
+    };
+
+    template<typename T>
+    struct FilterTraits<Added<T>> {
+        using Component = std::remove_const_t<T>;
+        static constexpr bool ADDED = true;
+    };
+}
+
+// storage type for a (possibly const) component type, keeps constness of the view
+template<typename T>
+using StorageFor = std::conditional_t<std::is_const_v<T>,
+    const ComponentStorage<std::remove_const_t<T>>,
+    ComponentStorage<std::remove_const_t<T>>>;
+
+/*
+ * View over every entity that owns all of Ts.
+ * Iteration is driven by the smallest pool. Views created by World test the entity's signature
+ * against the view mask (one AND per entity) instead of probing every other pool.
+ * Do not add/remove components of the viewed types while iterating, use a deferred pass for that.
+ *
+ * filter<ECS::Changed<T>>(sinceTick) / filter<ECS::Added<T>>(sinceTick) keeps only entities whose T was
+ * changed / added after sinceTick. The filtered view is driven by the first filter's pool and skips
+ * entries by scanning its tick array, so when few components changed almost nothing else is touched.
+ */
+template<typename... Ts>
+class View {
+    static_assert(sizeof...(Ts) > 0, "View needs at least one component type");
+
+public:
+    explicit View(StorageFor<Ts>&... pools);
+
+    // signatures: per entity slot, kept up to date by World
+    explicit View(const std::vector<ECS::Signature>& signatures, StorageFor<Ts>&... pools);
+
+    // func(Entity, Ts&...) or func(Ts&...)
+    template<typename Func>
+    void each(Func&& func) const { each(0, m_driver->size(), std::forward<Func>(func)); };
+
+    // each() restricted to driving-pool positions [begin, end), used to split a view into chunks
+    template<typename Func>
+    void each(size_t begin, size_t end, Func&& func) const;
+
+    // range of std::tuple<Entity, Ts&...>, for: for (auto [e, transform, mesh] : view.each())
+    class Iterator;
+    // holds a copy of the view (a few pointers), so for (... : world.view<...>().each()) doesn't dangle
+    struct Range {
+        View view;
+        [[nodiscard]] Iterator begin() const { return Iterator(&view, 0); };
+        [[nodiscard]] Iterator end() const { return Iterator(&view, view.m_driver->size()); };
+    };
+    [[nodiscard]] Range each() const { return Range{ *this }; };
+
+    // copy of this view that only visits entities matching every filter (ECS::Changed<T> / ECS::Added<T>)
+    template<typename... Filters>
+    [[nodiscard]] View filter(uint32_t sinceTick) const;
+
+    [[nodiscard]] bool contains(Entity e) const;
+
+    template<typename T>
+    [[nodiscard]] T& get(Entity e) const;
+
+    [[nodiscard]] std::tuple<Ts&...> getAll(Entity e) const { return std::tuple<Ts&...>(get<Ts>(e)...); };
+
+    // upper bound of matching entities (size of the driving pool)
+    [[nodiscard]] size_t sizeHint() const { return m_driver->size(); };
+    [[nodiscard]] const std::vector<Entity>& getDrivingEntities() const { return *m_driver; };
+
+    class Iterator {
+    public:
+        Iterator(const View* view, size_t index) : m_view(view), m_index(index) { skip(); };
+
+        std::tuple<Entity, Ts&...> operator*() const {
+            const Entity e = (*m_view->m_driver)[m_index];
+            return std::tuple<Entity, Ts&...>(e, m_view->template get<Ts>(e)...);
+        };
+        Iterator& operator++() { ++m_index; skip(); return *this; };
+        bool operator==(const Iterator& other) const { return m_index == other.m_index; };
+        bool operator!=(const Iterator& other) const { return m_index != other.m_index; };
+
+    private:
+        void skip() {
+            const auto& entities = *m_view->m_driver;
+            while (m_index < entities.size() && !m_view->acceptsAt(m_index)) ++m_index;
+        };
+
+        const View* m_view;
+        size_t m_index;
+    };
+
+private:
+    struct TickFilter {
+        const IComponentStorage* pool;
+        bool added;
+    };
+
+    // iteration filter for entities of the driving pool
+    [[nodiscard]] bool accepts(Entity e) const;
+    // same, plus the tick filters, for position index of the driving pool
+    [[nodiscard]] bool acceptsAt(size_t index) const;
+
+    template<typename C>
+    [[nodiscard]] const ComponentStorage<C>* findPool() const;
+    template<typename Filter>
+    void addFilter();
+
+    std::tuple<StorageFor<Ts>*...> m_pools;
+    const std::vector<Entity>* m_driver = nullptr;
+
+    const std::vector<ECS::Signature>* m_signatures = nullptr;
+    ECS::Signature m_mask;
+
+    // tick filters, the first one drives iteration (m_driverTicks is parallel to m_driver)
+    std::array<TickFilter, sizeof...(Ts) * 2> m_filters{};
+    size_t m_filterCount = 0;
+    const std::vector<uint32_t>* m_driverTicks = nullptr;
+    uint32_t m_sinceTick = 0;
+};
+
+
+/*
+ * Owning group (EnTT style): the group takes ownership of the pools of Ts and keeps every
+ * entity that has all of them packed at the front of each pool, in the same order.
+ * Iterating a group is a straight linear walk over parallel dense arrays, no probing at all.
+ * A pool can be owned by one group only, and components must be added/removed through World
+ * so the group can keep its packed range up to date.
+ */
+class IGroup {
+public:
+    virtual ~IGroup() = default;
+
+    virtual void onComponentAdded(Entity e) = 0;
+    virtual void onComponentRemoved(Entity e) = 0;
+};
+
+template<typename... Ts>
+class Group final : public IGroup {
+    static_assert(sizeof...(Ts) > 1, "an owning group needs at least two component types");
+
+public:
+    explicit Group(ComponentStorage<Ts>&... pools);
+
+    void onComponentAdded(Entity e) override;
+    void onComponentRemoved(Entity e) override;
+
+    // func(Entity, Ts&...) or func(Ts&...)
+    template<typename Func>
+    void each(Func&& func);
+
+    [[nodiscard]] size_t size() const { return m_size; };
+    [[nodiscard]] bool contains(Entity e) const;
+
+    // packed entity range, index i matches index i of each owned pool
+    [[nodiscard]] const Entity* getEntities() const { return std::get<0>(m_pools)->getEntities().data(); };
+
+private:
+    void swapInto(size_t slot, Entity e);
+
+    std::tuple<ComponentStorage<Ts>*...> m_pools;
+    size_t m_size = 0;
+};
+
+
+// Declarations
+template<typename... Ts>
+View<Ts...>::View(StorageFor<Ts>&... pools)
+    : m_pools(&pools...)
+{
+    // drive iteration from the smallest pool
+    const std::array<const std::vector<Entity>*, sizeof...(Ts)> candidates{ &pools.getEntities()... };
+    m_driver = candidates[0];
+    for (const auto* entities : candidates) {
+        if (entities->size() < m_driver->size()) m_driver = entities;
+    }
+}
+
+template<typename... Ts>
+View<Ts...>::View(const std::vector<ECS::Signature>& signatures, StorageFor<Ts>&... pools)
+    : View(pools...)
+{
+    m_signatures = &signatures;
+    m_mask = ECS::makeSignature<Ts...>();
+}
+
+template<typename... Ts>
+template<typename Func>
+void View<Ts...>::each(size_t begin, size_t end, Func&& func) const {
+    const auto& entities = *m_driver;
+    for (size_t i = begin; i < end; ++i) {
+        if (!acceptsAt(i)) continue;
+        const Entity e = entities[i];
+
+        if constexpr (std::is_invocable_v<Func, Entity, Ts&...>) {
+            func(e, get<Ts>(e)...);
+        } else {
+            func(get<Ts>(e)...);
+        }
+    }
+}
+
+template<typename... Ts>
+bool View<Ts...>::contains(Entity e) const {
+    return std::apply([e](const auto*... pools) { return (pools->contains(e) && ...); }, m_pools);
+}
+
+template<typename... Ts>
+bool View<Ts...>::accepts(Entity e) const {
+    if (m_signatures) {
+        // e comes from the driving pool so it is alive, its slot's signature is current
+        return ((*m_signatures)[ECS::getIndex(e)] & m_mask) == m_mask;
+    }
+    return contains(e);
+}
+
+template<typename... Ts>
+bool View<Ts...>::acceptsAt(size_t index) const {
+    if (m_driverTicks && (*m_driverTicks)[index] <= m_sinceTick) return false;
+
+    const Entity e = (*m_driver)[index];
+    if (!accepts(e)) return false;
+
+    // the first filter is the driver, already checked above
+    for (size_t i = 1; i < m_filterCount; ++i) {
+        const auto& filter = m_filters[i];
+        const uint32_t tick = filter.added ? filter.pool->getAddedTick(e) : filter.pool->getChangedTick(e);
+        if (tick <= m_sinceTick) return false;
+    }
+    return true;
+}
+
+template<typename... Ts>
+template<typename... Filters>
+View<Ts...> View<Ts...>::filter(uint32_t sinceTick) const {
+    static_assert(sizeof...(Filters) > 0, "filter needs at least one ECS::Changed<T> / ECS::Added<T>");
+    static_assert(sizeof...(Filters) <= sizeof...(Ts) * 2, "too many filters for this view");
+
+    View view = *this;
+    view.m_sinceTick = sinceTick;
+    view.m_filterCount = 0;
+    (view.template addFilter<Filters>(), ...);
+    return view;
+}
+
+template<typename... Ts>
+template<typename C>
+const ComponentStorage<C>* View<Ts...>::findPool() const {
+    constexpr bool hasMutable = (std::is_same_v<Ts, C> || ...);
+    constexpr bool hasConst = (std::is_same_v<Ts, const C> || ...);
+    static_assert(hasMutable || hasConst, "filtered component type must be one of the view's types");
+
+    if constexpr (hasMutable) {
+        return std::get<ComponentStorage<C>*>(m_pools);
+    } else {
+        return std::get<const ComponentStorage<C>*>(m_pools);
+    }
+}
+
+template<typename... Ts>
+template<typename Filter>
+void View<Ts...>::addFilter() {
+    using Traits = ECS::FilterTraits<Filter>;
+    const auto* pool = findPool<typename Traits::Component>();
+
+    if (m_filterCount == 0) {
+        m_driver = &pool->getEntities();
+        m_driverTicks = Traits::ADDED ? &pool->getAddedTicks() : &pool->getChangedTicks();
+    }
+    m_filters[m_filterCount++] = TickFilter{ pool, Traits::ADDED };
+}
+
+template<typename... Ts>
+template<typename T>
+T& View<Ts...>::get(Entity e) const {
+    return *std::get<StorageFor<T>*>(m_pools)->get(e);
+}
+
+template<typename... Ts>
+Group<Ts...>::Group(ComponentStorage<Ts>&... pools)
+    : m_pools(&pools...)
+{
+    // pull every entity that already matches into the packed range
+    const std::array<const std::vector<Entity>*, sizeof...(Ts)> candidates{ &pools.getEntities()... };
+    const std::vector<Entity>* driver = candidates[0];
+    for (const auto* entities : candidates) {
+        if (entities->size() < driver->size()) driver = entities;
+    }
+
+    // copy, swapping reorders the driving pool itself
+    const std::vector<Entity> entities = *driver;
+    for (const Entity e : entities) {
+        onComponentAdded(e);
+    }
+}
+
+template<typename... Ts>
+void Group<Ts...>::onComponentAdded(Entity e) {
+    const bool hasAll = std::apply([e](const auto*... pools) { return (pools->contains(e) && ...); }, m_pools);
+    if (!hasAll || contains(e)) return;
+
+    swapInto(m_size, e);
+    ++m_size;
+}
+
+template<typename... Ts>
+void Group<Ts...>::onComponentRemoved(Entity e) {
+    if (!contains(e)) return;
+
+    // move it to the last slot of the packed range, then shrink the range
+    --m_size;
+    swapInto(m_size, e);
+}
+
+template<typename... Ts>
+template<typename Func>
+void Group<Ts...>::each(Func&& func) {
+    auto components = std::apply([](auto*... pools) { return std::make_tuple(pools->getAll().data()...); }, m_pools);
+    const Entity* entities = getEntities();
+
+    for (size_t i = 0; i < m_size; ++i) {
+        std::apply([&](auto*... data) {
+            if constexpr (std::is_invocable_v<Func, Entity, Ts&...>) {
+                func(entities[i], data[i]...);
+            } else {
+                func(data[i]...);
+            }
+        }, components);
+    }
+}
+
+template<typename... Ts>
+bool Group<Ts...>::contains(Entity e) const {
+    const auto* pool = std::get<0>(m_pools);
+    return pool->contains(e) && pool->indexOf(e) < m_size;
+}
+
+template<typename... Ts>
+void Group<Ts...>::swapInto(size_t slot, Entity e) {
+    std::apply([slot, e](auto*... pools) { (pools->swapDense(slot, pools->indexOf(e)), ...); }, m_pools);
+}
@@ -2,36 +2,215 @@
 // Created by pointerlost on 8/6/25.
 //
 #pragma once
+#include <array>
 #include <iostream>
-#include <queue>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <typeindex>
 #include <unordered_map>
+#include <vector>
 
 #include "ComponentStorage.h"
+#include "ComponentType.h"
 #include "Entity.h"
+#include "View.h"
+#include "core/Logger.h"
 
-enum struct ComponentTypes {
-    TransformComponent,
-    MeshComponent,
-    MaterialComponent,
-    LightComponent,
-    CameraComponent
-};
-
+/*
+ * A World owns its entities and component pools, two worlds share nothing.
+ * A World is not thread-safe, but separate worlds can be built on separate threads
+ * (e.g. a level built on a loader thread) and then spliced into the live one with merge().
+ */
 class World {
 public:
+    World();
+
+    World(World&&) noexcept = default;
+    World& operator=(World&&) noexcept = default;
+
+    World(const World&) = delete;
+    World& operator=(const World&) = delete;
+
+    // moves every entity and component of other into this world, other is left empty.
+    // If this world never allocated a slot the whole world is taken over with a single move; if it has
+    // no live entities the slot indices of other are kept, with generations that never revive our old handles.
+    // Imported entities get new handles here (returned, indexed by their slot index in other),
+    // so components that store Entity handles have to be fixed up by the caller.
+    // Fails (all-null remap, both worlds untouched) when this world can't hold other's entities.
+    std::vector<Entity> merge(World&& other);
+
+    // recycles the slot of a destroyed entity when one is free (with a bumped generation)
     Entity createEntity();
 
+    // makes room for count more createEntity() calls without reallocating (free slots are counted in)
+    void reserveEntities(size_t count);
+
     void deleteEntity(Entity e);
 
+    // false for NullEntity and for handles whose slot was destroyed/recycled since
+    [[nodiscard]] bool isAlive(Entity e) const;
+    [[nodiscard]] size_t getAliveCount() const { return m_entities.size() - 1 - m_freeIndices.size(); };
+
+    // component types the entity owns (one bit per ECS::ComponentTypeID)
+    [[nodiscard]] const ECS::Signature& getSignature(Entity e) const { return m_signatures[ECS::getIndex(e)]; };
+
     template<typename T>
     void addComponent(Entity e, T c);
 
+    template<typename T>
+    void removeComponent(Entity e);
+
     template<typename T>
     T* getComponent(Entity e);
 
+    // change tracking: record that e's T was modified (at the current tick, or at a system's tick)
+    template<typename T>
+    void markChanged(Entity e) { markChanged<T>(e, m_tick); };
+    template<typename T>
+    void markChanged(Entity e, uint32_t tick) { getStorage<T>().markChanged(e, tick); };
+
+    // func(T&) then markChanged, does nothing if e has no T
+    template<typename T, typename Func>
+    void patch(Entity e, Func&& func);
+
+    // current tick, stamped on components added/changed through World.
+    // Starts at 1 so a consumer that never ran (since tick 0) sees everything.
+    [[nodiscard]] uint32_t getTick() const { return m_tick; };
+
+    // reserves count ticks for the caller (e.g. one per system of a frame) and returns the first one,
+    // the world's own tick moves past them
+    uint32_t advanceTick(uint32_t count = 1);
+
     template<typename T>
     ComponentStorage<T>& getStorage();
 
+    template<typename T>
+    const ComponentStorage<T>& getStorage() const;
+
+    // iterate every entity that has all of Ts, e.g. world.view<TransformComponent, MeshComponent>()
+    template<typename... Ts>
+    View<Ts...> view() { return View<Ts...>(m_signatures, getStorage<std::remove_const_t<Ts>>()...); };
+
+    template<typename... Ts>
+    View<const Ts...> view() const { return View<const Ts...>(m_signatures, getStorage<Ts>()...); };
+
+    // owning group, keeps Ts packed in the same order inside their pools (created on first use)
+    template<typename... Ts>
+    Group<Ts...>& group();
+
 private:
-    Entity nextID = 1;
+    // reads/writes the entity table and pools directly
+    friend class WorldSnapshot;
+
+    // slot index -> current handle of that slot (index 0 is reserved for NullEntity)
+    std::vector<Entity> m_entities;
+
+    // destroyed slots waiting to be reused, used as a stack so recently freed (hot) slots come back first
+    std::vector<uint32_t> m_freeIndices;
+
+    // slot index -> component types owned by the entity in that slot
+    std::vector<ECS::Signature> m_signatures;
+
+    // type-erased pool table, indexed by ECS::ComponentTypeID (nullptr = type never used by this world)
+    std::vector<std::unique_ptr<IComponentStorage>> m_pools;
+
+    std::unordered_map<std::type_index, std::unique_ptr<IGroup>> m_groups;
+
+    // component type ID -> the group that owns its pool (a pool has at most one owner)
+    std::array<IGroup*, ECS::MAX_COMPONENT_TYPES> m_poolOwners{};
+
+    uint32_t m_tick = 1;
 };
+
+
+// Declarations
+template<typename T>
+void World::addComponent(Entity e, T c) {
+    if (!isAlive(e)) {
+        Logger::warn("[World::addComponent] entity " + std::to_string(e) + " is not alive!");
+        return;
+    }
+    const ECS::ComponentTypeID type = ECS::getComponentTypeID<T>();
+
+    getStorage<T>().add(e, std::move(c), m_tick);
+    m_signatures[ECS::getIndex(e)].set(type);
+
+    if (IGroup* owner = m_poolOwners[type]) owner->onComponentAdded(e);
+}
+
+template<typename T>
+void World::removeComponent(Entity e) {
+    if (!isAlive(e)) return;
+    const ECS::ComponentTypeID type = ECS::getComponentTypeID<T>();
+
+    // the group has to release the entity before the pool swaps it out
+    if (IGroup* owner = m_poolOwners[type]) owner->onComponentRemoved(e);
+
+    getStorage<T>().remove(e);
+    m_signatures[ECS::getIndex(e)].reset(type);
+}
+
+template<typename T>
+T* World::getComponent(Entity e) {
+    return getStorage<T>().get(e);
+}
+
+template<typename T, typename Func>
+void World::patch(Entity e, Func&& func) {
+    auto& storage = getStorage<T>();
+    if (T* comp = storage.get(e)) {
+        func(*comp);
+        storage.markChanged(e, m_tick);
+    }
+}
+
+template<typename T>
+ComponentStorage<T>& World::getStorage() {
+    const ECS::ComponentTypeID type = ECS::getComponentTypeID<T>();
+    if (type >= m_pools.size()) {
+        if (type >= ECS::MAX_COMPONENT_TYPES) {
+            throw std::runtime_error("[World::getStorage] too many component types, raise ECS::MAX_COMPONENT_TYPES");
+        }
+        m_pools.resize(type + 1);
+    }
+
+    // pools are created the first time this world touches the type
+    auto& pool = m_pools[type];
+    if (!pool) {
+        pool = std::make_unique<ComponentStorage<T>>();
+    }
+    return static_cast<ComponentStorage<T>&>(*pool);
+}
+
+template<typename T>
+const ComponentStorage<T>& World::getStorage() const {
+    const ECS::ComponentTypeID type = ECS::getComponentTypeID<T>();
+    if (type < m_pools.size() && m_pools[type]) {
+        return static_cast<const ComponentStorage<T>&>(*m_pools[type]);
+    }
+
+    // a const world can't create pools, a type it never used is just empty
+    static const ComponentStorage<T> empty;
+    return empty;
+}
+
+template<typename... Ts>
+Group<Ts...>& World::group() {
+    const std::type_index key(typeid(Group<Ts...>));
+    if (const auto it = m_groups.find(key); it != m_groups.end()) {
+        return static_cast<Group<Ts...>&>(*it->second);
+    }
+
+    for (const ECS::ComponentTypeID type : { ECS::getComponentTypeID<Ts>()... }) {
+        if (m_poolOwners[type]) {
+            throw std::runtime_error("[World::group] pool is already owned by another group! type id: " + std::to_string(type));
+        }
+    }
+
+    auto group = std::make_unique<Group<Ts...>>(getStorage<Ts>()...);
+    auto& ref = *group;
+    ((m_poolOwners[ECS::getComponentTypeID<Ts>()] = &ref), ...);
+    m_groups.emplace(key, std::move(group));
+    return ref;
+}
@@ -0,0 +1,69 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include "ComponentStorage.h"
+#include "ComponentType.h"
+#include "World.h"
+
+/*
+ * Binary World snapshot.
+ *
+ *   Header         magic, version, sizes, world tick
+ *   slot table     uint32 handle per entity slot (generations included, so handles survive a round trip)
+ *   free table     uint32 free slot indices
+ *   type table     per pool: type hash, component size, count, blob offsets
+ *   blobs          per pool: dense entity array, then the dense component array, 16-byte aligned
+ *
+ * Pools are written as they sit in memory and read back with one bulk copy each, the file is
+ * memory-mapped on load (plain read on Windows). Cost scales with bytes, not entity count.
+ * Types are matched by the hash of the name given to registerType(), not by ECS::ComponentTypeID
+ * (those depend on first-use order). Pools of unregistered types are skipped on save and on load.
+ * Files are native endian, they are a cache, not an interchange format.
+ */
+class WorldSnapshot {
+public:
+    static constexpr uint32_t VERSION = 1;
+
+    // name must stay the same across builds, it is what identifies the pool in the file
+    template<typename T>
+    static void registerType(std::string_view name);
+
+    [[nodiscard]] static bool save(const World& world, const std::string& path);
+
+    // replaces the whole content of world (groups included) with the snapshot, world is untouched on failure
+    [[nodiscard]] static bool load(World& world, const std::string& path);
+
+private:
+    struct TypeInfo {
+        uint64_t hash;
+        uint32_t componentSize;
+        ECS::ComponentTypeID typeID;
+        std::unique_ptr<IComponentStorage> (*createPool)();
+    };
+
+    [[nodiscard]] static uint64_t hashName(std::string_view name);
+    static void addType(const TypeInfo& info, std::string_view name);
+    [[nodiscard]] static const TypeInfo* findByHash(uint64_t hash);
+    [[nodiscard]] static const TypeInfo* findByTypeID(ECS::ComponentTypeID typeID);
+
+    static std::vector<TypeInfo>& registry();
+};
+
+
+// Declarations
+template<typename T>
+void WorldSnapshot::registerType(std::string_view name) {
+    static_assert(std::is_trivially_copyable_v<T>, "only trivially copyable components can be snapshotted");
+    static_assert(std::is_default_constructible_v<T>, "snapshotted components must be default constructible");
+
+    addType(TypeInfo{
+        .hash = hashName(name),
+        .componentSize = static_cast<uint32_t>(sizeof(T)),
+        .typeID = ECS::getComponentTypeID<T>(),
+        .createPool = [] { return std::unique_ptr<IComponentStorage>(std::make_unique<ComponentStorage<T>>()); },
+    }, name);
+}
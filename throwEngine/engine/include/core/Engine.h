@@ -1,6 +1,9 @@
 #pragma once
 #include "core/Window.h"
 #include "core/File.h"
+#include "core/ThreadPool.h"
+#include "World.h"
+#include "SystemScheduler.h"
 #include "graphics/Renderer/Renderer.h"
 #include "graphics/Camera/CameraController.h"
 #include "graphics/Shaders/ShaderManager.h"
@@ -98,6 +101,12 @@ namespace core
 
 		std::unique_ptr<ENGINE::UI::ImGuiLayer> m_imGuiLayer;
 
+		std::unique_ptr<core::ThreadPool> m_threadPool;
+
+		std::unique_ptr<World> m_world;
+
+		std::unique_ptr<SystemScheduler> m_scheduler;
+
 		void initWindow();
 
 		void initCallBack() noexcept;
@@ -124,6 +133,8 @@ namespace core
 
 		void initLighting();
 
+		void initSystems();
+
 		void OpenGLSetUpResources() noexcept;
 		void OpenGLRenderStuff()    noexcept;
 		void glfwRenderEventStuff() const  noexcept;
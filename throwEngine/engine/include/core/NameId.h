@@ -0,0 +1,105 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace core {
+
+	/*
+	 * 32-bit id of an interned string (object, material, shader, texture names). Equal strings get equal ids,
+	 * so comparing and hashing names is an integer compare. The default id is the empty string and counts as
+	 * invalid, like an unnamed object. Ids are only meaningful within one run, use getHash() for anything persisted.
+	 */
+	class NameId {
+	public:
+		constexpr NameId() = default;
+
+		// interns name (thread-safe), the empty string is the invalid id
+		explicit NameId(std::string_view name);
+
+		// id of name if it was ever interned, invalid otherwise. Never adds to the table, for lookups by string
+		[[nodiscard]] static NameId find(std::string_view name);
+
+		// the interned string, stable for the whole run
+		[[nodiscard]] const std::string& str() const;
+
+		// 64-bit FNV-1a of the string, computed once at intern time
+		[[nodiscard]] uint64_t getHash() const;
+
+		[[nodiscard]] constexpr uint32_t getIndex() const { return m_index; };
+		[[nodiscard]] constexpr bool isValid() const { return m_index != 0; };
+
+		constexpr bool operator==(const NameId&) const = default;
+
+	private:
+		friend class StringInterner;
+		constexpr explicit NameId(uint32_t index) : m_index(index) {};
+
+		uint32_t m_index = 0;
+	};
+
+	/*
+	 * Process-wide string table behind NameId. Lookups of existing strings share a reader lock, only new strings
+	 * take the writer lock. Entries live in fixed-size chunks that never move, so str() of an id needs no lock
+	 * and the returned reference stays valid; nothing is ever removed.
+	 */
+	class StringInterner {
+	public:
+		static StringInterner& get();
+
+		[[nodiscard]] NameId intern(std::string_view string);
+		[[nodiscard]] NameId find(std::string_view string) const;
+
+		[[nodiscard]] const std::string& getString(NameId id) const;
+		[[nodiscard]] uint64_t getHash(NameId id) const;
+
+		// interned strings, the empty string included
+		[[nodiscard]] size_t size() const { return m_count.load(std::memory_order_acquire); };
+
+		[[nodiscard]] static uint64_t hashString(std::string_view string);
+
+	private:
+		StringInterner();
+		~StringInterner();
+		StringInterner(const StringInterner&) = delete;
+		void operator=(const StringInterner&) = delete;
+
+		struct Entry {
+			std::string string;
+			uint64_t hash = 0;
+		};
+
+		// the map key carries the precomputed hash, rehashing never touches the string again
+		struct Key {
+			std::string_view string;
+			uint64_t hash;
+
+			bool operator==(const Key& other) const { return string == other.string; };
+		};
+		struct KeyHash {
+			size_t operator()(const Key& key) const noexcept { return static_cast<size_t>(key.hash); };
+		};
+
+		static constexpr uint32_t CHUNK_BITS = 12;
+		static constexpr uint32_t CHUNK_SIZE = 1u << CHUNK_BITS;
+		static constexpr uint32_t MAX_CHUNKS = 1024;
+
+		[[nodiscard]] const Entry& entry(uint32_t index) const;
+
+		mutable std::shared_mutex m_mutex;
+		std::unordered_map<Key, uint32_t, KeyHash> m_lookup;
+		std::array<std::atomic<Entry*>, MAX_CHUNKS> m_chunks{};
+		std::atomic<uint32_t> m_count = 0;
+	};
+}
+
+// ids are unique and dense, the index itself is a collision-free hash for unordered containers
+template<>
+struct std::hash<core::NameId> {
+	size_t operator()(const core::NameId& id) const noexcept { return id.getIndex(); };
+};
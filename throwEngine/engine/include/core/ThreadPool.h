@@ -0,0 +1,87 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace core {
+
+	/*
+	 * Fixed-size worker pool with one shared job queue.
+	 * Jobs are tracked with a caller-owned counter instead of a global "wait for everything",
+	 * so a job running on a worker can itself fan out (parallelFor inside a system) and wait
+	 * for its own children. A waiting thread keeps executing queued jobs, it never sleeps
+	 * while there is work, which also means nested waits can't deadlock the pool.
+	 */
+	class ThreadPool {
+	public:
+		using Job = std::function<void()>;
+
+		// threadCount workers besides the calling (main) thread, 0 = hardware_concurrency - 1
+		explicit ThreadPool(size_t threadCount = 0);
+		~ThreadPool();
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		// counter (optional) is decremented once job finished, increment it before submitting
+		void submit(Job job, std::atomic<size_t>* counter = nullptr);
+
+		// runs queued jobs on the calling thread until counter reaches zero
+		void waitFor(const std::atomic<size_t>& counter);
+
+		// func(begin, end) over [0, count) split in chunks of chunkSize, blocks until every chunk is done
+		template<typename Func>
+		void parallelFor(size_t count, size_t chunkSize, Func&& func);
+
+		// runs one queued job on the calling thread, false if the queue was empty
+		bool runPendingJob();
+
+		// workers + the calling thread
+		[[nodiscard]] size_t getConcurrency() const { return m_workers.size() + 1; };
+
+		// 0 on any thread that isn't a worker of a pool (main thread), 1..N on workers
+		[[nodiscard]] static uint32_t getWorkerIndex();
+
+	private:
+		void workerLoop(uint32_t workerIndex);
+
+		std::vector<std::thread> m_workers;
+		std::deque<Job> m_jobs;
+		std::mutex m_mutex;
+		std::condition_variable m_condition;
+		bool m_stop = false;
+	};
+
+
+	// Declarations
+	template<typename Func>
+	void ThreadPool::parallelFor(size_t count, size_t chunkSize, Func&& func)
+	{
+		if (count == 0) return;
+		chunkSize = std::max<size_t>(chunkSize, 1);
+
+		// small ranges aren't worth the queue round trip
+		if (count <= chunkSize || m_workers.empty()) {
+			func(size_t(0), count);
+			return;
+		}
+
+		const size_t chunkCount = (count + chunkSize - 1) / chunkSize;
+		std::atomic<size_t> pending = chunkCount - 1;
+
+		for (size_t chunk = 1; chunk < chunkCount; ++chunk) {
+			const size_t begin = chunk * chunkSize;
+			const size_t end = std::min(begin + chunkSize, count);
+			submit([&func, begin, end] { func(begin, end); }, &pending);
+		}
+
+		// the calling thread takes the first chunk itself
+		func(size_t(0), std::min(chunkSize, count));
+		waitFor(pending);
+	}
+}
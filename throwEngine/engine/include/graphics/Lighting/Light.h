@@ -25,10 +25,16 @@ namespace LIGHTING
 
 		[[nodiscard]] std::shared_ptr<LightData> getLightData() const { return m_lightData; };
 
+		// the scene object that shows where the light is, its name is the light's name
+		void setVisual(const SCENE::SceneObject& visual) { m_visual = visual; };
+		[[nodiscard]] const SCENE::SceneObject& getVisual() const { return m_visual; };
+
 	private:
 		// Light data storage the light properties for sending gpu (with uniforms etc.)
 		std::shared_ptr<LightData> m_lightData;
 
+		SCENE::SceneObject m_visual;
+
 		// Light type, point = 0, directional = 1, spot = 2 (changeable with new properties later maybe.)
 		LightType m_type;
 	};
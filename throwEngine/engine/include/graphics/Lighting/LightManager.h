@@ -2,7 +2,8 @@
 #include <vector>
 #include <unordered_map>
 #include <memory>
-#include <stack>
+#include "core/NameId.h"
+#include "Scene/SceneHandle.h"
 
 namespace LIGHTING
 {
@@ -23,29 +24,39 @@ namespace LIGHTING
 	public:
 		LightManager() = default;
 
-		void setLightUniforms(const std::shared_ptr<SHADER::GLShaderProgram>& shader,
+		// writes light into lights[index], false (nothing written) if the light has no data
+		bool setLightUniforms(const std::shared_ptr<SHADER::GLShaderProgram>& shader,
 			size_t index, const std::shared_ptr<Light>& light);
 
 		void uploadLights(const std::shared_ptr<SHADER::GLShaderProgram>& shader);
 
-		[[nodiscard]] uint32_t getActiveLightCount() const { return m_lightMap.size(); };
+		[[nodiscard]] uint32_t getActiveLightCount() const { return static_cast<uint32_t>(m_lights.size()); };
 
-		std::vector<std::shared_ptr<Light>> getLights() const { return m_lights; }
+		[[nodiscard]] const std::vector<std::shared_ptr<Light>>& getLights() const { return m_lights; }
 
-		bool checkLightExists(const std::string& name) const;
+		// lights are keyed by the handle of their visual scene object (Light::getVisual)
+		[[nodiscard]] bool checkLightExists(SCENE::SceneHandle handle) const;
 
 		void addLight(const std::shared_ptr<Light>& light);
-		void removeLight(const std::string& name);
-		[[nodiscard]] std::shared_ptr<Light> getLight(const std::string& name) const;
+		void removeLight(SCENE::SceneHandle handle);
+		[[nodiscard]] std::shared_ptr<Light> getLight(SCENE::SceneHandle handle) const;
 
 	private:
+		// "lights[i].position", ... interned once per slot, uploads don't build uniform names every frame
+		struct LightUniformNames {
+			core::NameId position;
+			core::NameId direction;
+			core::NameId diffuse;
+			core::NameId specular;
+		};
+		const LightUniformNames& getUniformNames(size_t index);
+
+		std::vector<LightUniformNames> m_uniformNames;
+
+		// dense, lights[i] is uploaded as lights[i] in the shader. Removal swaps the last light into the hole
 		std::vector<std::shared_ptr<Light>> m_lights;
 
-		std::stack<size_t> m_NullIndexStackOfLights;
-
-		std::unordered_map<std::string, uint32_t> getFreeIndexWithName;
-
-		// get light with the name of scene object
-		std::unordered_map<std::string, std::shared_ptr<Light>> m_lightMap;
+		// visual object handle -> index in m_lights
+		std::unordered_map<SCENE::SceneHandle, uint32_t> m_lightIndex;
 	};
 }
@@ -12,7 +12,15 @@ namespace Graphics {
     struct Material;
 }
 
+namespace SHADER {
+    class IShader;
+}
+
 struct MaterialComponent {
     std::shared_ptr<Graphics::Material> material;
     std::shared_ptr<Graphics::Texture> texture;
+    // must read the model matrix per instance (basic_instanced), null = "basic_instanced"
+    std::shared_ptr<SHADER::IShader> shader;
+    // material is this entity's own copy, not the one shared through the MaterialLibrary
+    bool ownsMaterial = false;
 };
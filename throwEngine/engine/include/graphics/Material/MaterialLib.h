@@ -5,6 +5,7 @@
 #include <unordered_map>
 #include <nlohmann/json.hpp>
 
+#include "core/NameId.h"
 #include "graphics/Textures/Textures.h"
 
 // Forward declaration
@@ -17,7 +18,7 @@ namespace Graphics
 
 	struct Material
 	{
-		std::string m_name;
+		core::NameId m_name;
 
 		glm::vec3 m_ambient;
 		glm::vec3 m_diffuse;
@@ -38,10 +39,12 @@ namespace Graphics
 		[[nodiscard]] bool createMaterials(const std::string& filePath, Graphics::TextureManager& textureManager);
 
 		std::shared_ptr<Graphics::Material> getMaterialByName(const std::string& name);
+		// same without hashing the string, for callers that keep the id
+		std::shared_ptr<Graphics::Material> getMaterial(core::NameId name);
 
 		std::shared_ptr<Material> getDefaultMaterial();
 
 	private:
-		std::unordered_map<std::string, std::shared_ptr<Material>> m_materials;
+		std::unordered_map<core::NameId, std::shared_ptr<Material>> m_materials;
 	};
 }
\ No newline at end of file
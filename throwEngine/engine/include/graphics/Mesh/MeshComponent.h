@@ -3,15 +3,16 @@
 //
 #pragma once
 #include <memory>
-
-// add include for mesh data 3d if needed
+#include <string>
 
 namespace Graphics {
     class MeshData3D;
+    struct SubMeshInfo;
 }
 
 struct MeshComponent {
     std::shared_ptr<Graphics::MeshData3D> meshData;
     std::string subMeshName;
-    uint32_t VAO;
+    // resolved from subMeshName by Render::MeshRenderSystem on first draw, points into meshData
+    const Graphics::SubMeshInfo* subMesh = nullptr;
 };
@@ -3,6 +3,7 @@
 #include <memory>
 #include <glm/glm.hpp>
 #include <unordered_map>
+#include "Math/AABB.h"
 
 
 namespace Graphics {
@@ -25,6 +26,9 @@ namespace Graphics {
 
 		// VAO ownership
 		uint32_t VAO;
+
+		// model-space bounds of the sub-mesh's vertices, world bounds are MATH::transformAABB(localBounds, model)
+		MATH::AABB localBounds;
 	};
 
 	class MeshData
@@ -66,6 +70,8 @@ namespace Graphics {
 		void AddMeshDataIntoObjectMap(const std::string& name, SubMeshInfo& info);
 
 		SubMeshInfo& getObjectInfo(const std::string& name) { return objectInfo.at(name); };
+		// nullptr if there is no sub-mesh with that name, the pointer stays valid while this object lives
+		[[nodiscard]] const SubMeshInfo* findObjectInfo(const std::string& name) const;
 
 	private:
 		std::unordered_map<std::string, SubMeshInfo> objectInfo;
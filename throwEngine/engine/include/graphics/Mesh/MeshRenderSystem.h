@@ -2,21 +2,201 @@
 // Created by pointerlost on 8/6/25.
 //
 #pragma once
+#include <cstdint>
 #include <iostream>
+#include <unordered_map>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "graphics/Renderer/RenderQueue.h"
 
 // forward declarations
 class World;
-namespace Graphics { class Camera; }
-struct MeshComponent;
+struct MaterialComponent;
+namespace Graphics { class Camera; class RenderData; class MeshData3D; struct SubMeshInfo; struct Material; struct Texture; }
+namespace SHADER { class IShader; }
+namespace MATH { struct AABB; }
+namespace core { class ThreadPool; }
 
 namespace Render {
+    /*
+     * ECS draw path for entities with TransformComponent + MeshComponent + MaterialComponent.
+     *
+     * Entities whose world bounds (sub-mesh bounds through the world matrix) are outside the camera
+     * frustum are dropped before bucketing, tested Lanes::WIDTH at a time (MATH::cullAABBs) and spread
+     * over the thread pool when one is set.
+     * The remaining entities go into a RenderQueue under a 64-bit SortKey (pass | shader | texture | sub-mesh |
+     * depth | material) that is radix sorted, so draws with the same state end up next to each other and
+     * front to back inside their bucket. Every bucket (equal shader, texture and sub-mesh) is one instanced
+     * draw, whatever the materials of its entities: materials go into a storage buffer once per frame and
+     * every instance carries its index. Shader, lights and textures are only set when they change between
+     * consecutive buckets.
+     * With multi-draw indirect (the default) every bucket is a DrawElementsIndirectCommand in one buffer,
+     * and each run of buckets that binds the same state (all sub-meshes of a MeshData3D under one shader
+     * and texture) is a single glMultiDrawElementsIndirect. Otherwise one glDrawElementsInstancedBaseInstance
+     * per bucket.
+     * Every sub-mesh of a MeshData3D lives in its shared VBO/EBO, so there is one VAO per MeshData3D.
+     * Per-instance data (world matrix from the TransformPool, normal matrix, material index) goes into one
+     * instance buffer per frame, read at attributes 4-11 with baseInstance pointing at the bucket's first
+     * instance (see shaders/opengl/basic_instanced.vert/.frag). Main thread only, needs the GL context.
+     */
     class MeshRenderSystem {
     public:
-        void render(const World& world, const Graphics::Camera& camera);
+        MeshRenderSystem() = default;
+        ~MeshRenderSystem();
+
+        MeshRenderSystem(const MeshRenderSystem&) = delete;
+        MeshRenderSystem& operator=(const MeshRenderSystem&) = delete;
+
+        // world is not const, sub-mesh names are resolved into MeshComponent::subMesh once.
+        // threadPool (optional) runs the culling of large scenes in parallel
+        void render(World& world, const Graphics::Camera& camera, Graphics::RenderData& renderData,
+                    core::ThreadPool* threadPool = nullptr);
+
+        // on by default, off draws everything (debugging)
+        void setFrustumCulling(bool enabled) { m_frustumCulling = enabled; };
+        [[nodiscard]] bool isFrustumCulling() const { return m_frustumCulling; };
+
+        // on by default, off issues one draw call per bucket (debugging, GL captures)
+        void setMultiDrawIndirect(bool enabled) { m_multiDrawIndirect = enabled; };
+        [[nodiscard]] bool isMultiDrawIndirect() const { return m_multiDrawIndirect; };
+
+        // stats of the last render(), draw calls are GL calls (a multi-draw counts once)
+        [[nodiscard]] size_t getDrawCallCount() const { return m_drawCallCount; };
+        [[nodiscard]] size_t getBatchCount() const { return m_batches.size(); };
+        [[nodiscard]] size_t getInstanceCount() const { return m_instances.size(); };
+        [[nodiscard]] size_t getVisibleCount() const { return m_items.size(); };
+        [[nodiscard]] size_t getCulledCount() const { return m_culledCount; };
+        [[nodiscard]] uint32_t getSortPassCount() const { return m_queue.getSortPassCount(); };
 
     private:
-        void setupVAO(MeshComponent& comp);
+        // raw pointers only, no refcount traffic per entity. Pool storage doesn't move during render()
+        struct DrawItem {
+            // SortKey state bits, depth is added once the item survived culling
+            uint64_t stateKey;
+            SHADER::IShader* shader;
+            // the component's texture, else the material's diffuse texture
+            const Graphics::Texture* texture;
+            const Graphics::Texture* specularTexture;
+            const Graphics::MeshData3D* meshData;
+            uint32_t indexOffset;
+            uint32_t indexCount;
+            uint32_t transformID;
+            // into m_materials (the key's material field may have wrapped, this doesn't)
+            uint32_t materialIndex;
+            // sub-mesh bounds in model space
+            const MATH::AABB* localBounds;
+        };
+
+        // attributes 4-11 of basic_instanced.vert, tightly packed
+        struct InstanceData {
+            glm::mat4 model;
+            // transpose(inverse(model)) upper 3x3, once per instance instead of once per vertex
+            glm::mat3 normalMatrix;
+            uint32_t materialIndex;
+        };
+        static_assert(sizeof(InstanceData) == 26 * sizeof(float));
+
+        // GL's indirect command layout for glMultiDrawElementsIndirect
+        struct DrawElementsIndirectCommand {
+            uint32_t count;
+            uint32_t instanceCount;
+            uint32_t firstIndex;
+            int32_t baseVertex;
+            uint32_t baseInstance;
+        };
+
+        // one bucket: instances [firstInstance, firstInstance + instanceCount) of the queue, drawn with item's state
+        struct Batch {
+            const DrawItem* item;
+            uint32_t firstInstance;
+            uint32_t instanceCount;
+        };
+
+        // std430 element of basic_instanced.frag's material buffer
+        struct MaterialData {
+            glm::vec4 ambient;
+            glm::vec4 diffuse;
+            // w = shininess
+            glm::vec4 specular;
+        };
+
+        // VBO/EBO the VAO was built against, a new MeshData3D at a recycled address gets a new VAO
+        struct VertexArray {
+            uint32_t VAO = 0;
+            uint32_t VBO = 0;
+            uint32_t EBO = 0;
+        };
+
+        // dense per-frame ids for the SortKey fields, in first-seen order. Ids past a field's width wrap,
+        // submit() then still tells the states apart by pointer
+        template<typename T>
+        struct StateIds {
+            std::unordered_map<const T*, uint32_t> ids;
+            const T* last = nullptr;
+            uint32_t lastId = 0;
+
+            uint32_t get(const T* state);
+            void clear() { ids.clear(); last = nullptr; lastId = 0; };
+        };
+
+        void gather(World& world, Graphics::RenderData& renderData);
+        // drops the items outside the camera frustum from m_items
+        void cull(const Graphics::Camera& camera, Graphics::RenderData& renderData, core::ThreadPool* threadPool);
+        // keys (state + view depth) of the surviving items into m_queue, sorted
+        void buildQueue(const Graphics::Camera& camera, Graphics::RenderData& renderData, core::ThreadPool* threadPool);
+        void submit(Graphics::RenderData& renderData, core::ThreadPool* threadPool);
+        // splits the sorted queue into m_batches
+        void buildBatches();
+
+        uint32_t getVAO(const Graphics::MeshData3D& meshData);
+        void uploadInstances();
+        void uploadMaterials();
+        void uploadCommands();
+
+        // reused every frame
+        std::vector<DrawItem> m_items;
+        std::vector<InstanceData> m_instances;
+        // indexed by material id, every material gathered this frame
+        std::vector<MaterialData> m_materials;
+        std::vector<Batch> m_batches;
+        std::vector<DrawElementsIndirectCommand> m_commands;
+        // world bounds of m_items as SoA for the batched test
+        std::vector<float> m_centerX, m_centerY, m_centerZ;
+        std::vector<float> m_extentX, m_extentY, m_extentZ;
+        std::vector<uint8_t> m_visible;
+
+        RenderQueue m_queue;
+        StateIds<SHADER::IShader> m_shaderIds;
+        StateIds<Graphics::Material> m_materialIds;
+        StateIds<Graphics::Texture> m_textureIds;
+        StateIds<Graphics::SubMeshInfo> m_meshIds;
+
+        std::unordered_map<const Graphics::MeshData3D*, VertexArray> m_VAOs;
+        uint32_t m_instanceVBO = 0;
+        size_t m_instanceCapacity = 0;
+        uint32_t m_materialSSBO = 0;
+        size_t m_materialCapacity = 0;
+        uint32_t m_indirectBuffer = 0;
+        size_t m_commandCapacity = 0;
+
+        bool m_frustumCulling = true;
+        bool m_multiDrawIndirect = true;
+
+        size_t m_drawCallCount = 0;
+        size_t m_culledCount = 0;
     };
 
-}
 
+    // Declarations
+    template<typename T>
+    uint32_t MeshRenderSystem::StateIds<T>::get(const T* state)
+    {
+        // neighbouring entities mostly share their state, a run costs no map lookup
+        if (state == last && !ids.empty()) return lastId;
+
+        last = state;
+        lastId = ids.try_emplace(state, static_cast<uint32_t>(ids.size())).first->second;
+        return lastId;
+    }
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <cstdint>
+#include <glm/glm.hpp>
+
+namespace Graphics { class Camera; }
+
+namespace Render
+{
+	// uniform block binding of FrameData, every shader declares it as layout (std140, binding = 0)
+	constexpr uint32_t FRAME_DATA_BINDING = 0;
+
+	/*
+	 * Camera state shared by all programs, uploaded once per frame instead of per draw. std140 with only
+	 * mat4 and vec4 members, so the C++ layout matches without padding. Mirrors the FrameData block in
+	 * shaders/opengl, keep both in sync.
+	 */
+	struct FrameData {
+		glm::mat4 view;
+		glm::mat4 projection;
+		glm::mat4 viewProjection;
+		glm::mat4 inverseView;
+		glm::mat4 inverseProjection;
+		glm::mat4 inverseViewProjection;
+		glm::vec4 cameraPosition;	// w = time in seconds
+		glm::vec4 viewport;			// xy = size in pixels, zw = 1 / size
+	};
+	static_assert(sizeof(FrameData) == 6 * sizeof(glm::mat4) + 2 * sizeof(glm::vec4), "FrameData must match the std140 block");
+
+	// the uniform buffer behind FrameData, left bound at FRAME_DATA_BINDING
+	class FrameDataBuffer
+	{
+	public:
+		FrameDataBuffer() = default;
+		~FrameDataBuffer();
+
+		FrameDataBuffer(const FrameDataBuffer&) = delete;
+		FrameDataBuffer& operator=(const FrameDataBuffer&) = delete;
+
+		// fills FrameData from the camera and uploads it, the buffer is created on first use
+		void update(const Graphics::Camera& camera, float time, const glm::vec2& viewportSize);
+
+		[[nodiscard]] const FrameData& getData() const { return m_data; };
+
+	private:
+		uint32_t m_buffer = 0;
+		FrameData m_data{};
+	};
+}
@@ -9,6 +9,7 @@
 namespace Graphics   { class Camera;			};
 namespace Graphics  { class TextureManager;	};
 namespace Graphics { class MaterialLibrary; };
+namespace Graphics { class TransformPool; };
 namespace SHADER   { class GLShaderProgram; };
 namespace LIGHTING
 {
@@ -35,6 +36,9 @@ namespace Graphics
 		void setLightManager(const std::shared_ptr<LIGHTING::LightManager>& lightManager) { m_lightManager = lightManager; };
 		[[nodiscard]] std::shared_ptr<LIGHTING::LightManager> getLightManager() { return m_lightManager; };
 
+		void setTransformPool(const std::shared_ptr<Graphics::TransformPool>& transformPool) { m_transformPool = transformPool; };
+		[[nodiscard]] std::shared_ptr<Graphics::TransformPool> getTransformPool() const { return m_transformPool; };
+
 		void setGridRenderer(GRID::GridRenderer* gridRenderer) { m_gridRenderer = gridRenderer; };
 		[[nodiscard]] GRID::GridRenderer* getGridRenderer() { return m_gridRenderer; };
 		
@@ -43,6 +47,7 @@ namespace Graphics
 
 		[[nodiscard]] std::shared_ptr<SHADER::ShaderManager> getShaderManager() const { return m_shaderManager; };
 		[[nodiscard]] std::shared_ptr<SHADER::IShader> getShaderInterface(const std::string& name);
+		[[nodiscard]] std::shared_ptr<SHADER::IShader> getShaderInterface(core::NameId name);
 		[[nodiscard]] std::shared_ptr<SHADER::GLShaderProgram>& getWrapperGLShader();
 		//std::shared_ptr<SHADER::Shader> getWrappedShader(const std::string& name);
 		[[nodiscard]] const std::shared_ptr<Graphics::Camera> getCamera() const { return m_camera; };
@@ -60,6 +65,7 @@ namespace Graphics
 		std::shared_ptr<Graphics::TextureManager> m_textureManager;
 		std::shared_ptr<Graphics::MaterialLibrary> m_material;
 		std::shared_ptr<Graphics::Camera> m_camera;
+		std::shared_ptr<Graphics::TransformPool> m_transformPool;
 		GRID::GridRenderer* m_gridRenderer = nullptr;
 
 	private:
@@ -0,0 +1,98 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace core { class ThreadPool; }
+
+namespace Render
+{
+	/*
+	 * 64-bit draw sort key, most significant field first:
+	 *   pass 2 | shader 10 | texture 12 | mesh 12 | depth 14 | material 14
+	 * Sorting by key groups draws by their most expensive state first. Everything above depth is bound
+	 * per draw call, equal bits there mean the draws can share one instanced batch; material is
+	 * per-instance data, so it only breaks ties. Field values are small per-frame ids
+	 * (see MeshRenderSystem), not GL names.
+	 */
+	namespace SortKey
+	{
+		constexpr uint32_t PASS_BITS = 2;
+		constexpr uint32_t SHADER_BITS = 10;
+		constexpr uint32_t TEXTURE_BITS = 12;
+		constexpr uint32_t MESH_BITS = 12;
+		constexpr uint32_t DEPTH_BITS = 14;
+		constexpr uint32_t MATERIAL_BITS = 14;
+		static_assert(PASS_BITS + SHADER_BITS + TEXTURE_BITS + MESH_BITS + DEPTH_BITS + MATERIAL_BITS == 64);
+
+		constexpr uint32_t MATERIAL_SHIFT = 0;
+		constexpr uint32_t DEPTH_SHIFT = MATERIAL_SHIFT + MATERIAL_BITS;
+		constexpr uint32_t MESH_SHIFT = DEPTH_SHIFT + DEPTH_BITS;
+		constexpr uint32_t TEXTURE_SHIFT = MESH_SHIFT + MESH_BITS;
+		constexpr uint32_t SHADER_SHIFT = TEXTURE_SHIFT + TEXTURE_BITS;
+		constexpr uint32_t PASS_SHIFT = SHADER_SHIFT + SHADER_BITS;
+
+		// the fields one draw call binds: pass, shader, texture and mesh
+		constexpr uint64_t BATCH_MASK = ~((uint64_t(1) << MESH_SHIFT) - 1);
+
+		enum class Pass : uint32_t { Opaque = 0 };
+
+		// values wider than their field are masked, callers keep ids in range
+		[[nodiscard]] constexpr uint64_t field(uint32_t value, uint32_t bits, uint32_t shift) {
+			return (uint64_t(value) & ((uint64_t(1) << bits) - 1)) << shift;
+		};
+
+		// everything but depth
+		[[nodiscard]] constexpr uint64_t makeState(Pass pass, uint32_t shader, uint32_t texture, uint32_t mesh, uint32_t material) {
+			return field(static_cast<uint32_t>(pass), PASS_BITS, PASS_SHIFT) | field(shader, SHADER_BITS, SHADER_SHIFT)
+				| field(texture, TEXTURE_BITS, TEXTURE_SHIFT) | field(mesh, MESH_BITS, MESH_SHIFT)
+				| field(material, MATERIAL_BITS, MATERIAL_SHIFT);
+		};
+
+		// view distance quantized to DEPTH_BITS, logarithmic (top bits of the float), near to far
+		[[nodiscard]] uint64_t depthBits(float viewDistance);
+	}
+
+	/*
+	 * Draw items as (key, item index) pairs sorted by key with an LSD radix sort, 8 bits per pass.
+	 * Passes over bytes that are the same for every key (usually pass, shader and most of material)
+	 * are skipped. With a thread pool, histograms and scatter run per chunk in parallel; the sort is
+	 * stable, equal keys keep their push order.
+	 */
+	class RenderQueue
+	{
+	public:
+		struct Entry {
+			uint64_t key;
+			uint32_t item;
+		};
+
+		void clear() { m_entries.clear(); };
+		void reserve(size_t count) { m_entries.reserve(count); };
+		void push(uint64_t key, uint32_t item) { m_entries.push_back({ key, item }); };
+
+		// threadPool (optional) sorts large queues in parallel
+		void sort(core::ThreadPool* threadPool = nullptr);
+
+		[[nodiscard]] const std::vector<Entry>& getEntries() const { return m_entries; };
+		[[nodiscard]] std::vector<Entry>& getEntries() { return m_entries; };
+		[[nodiscard]] size_t size() const { return m_entries.size(); };
+		[[nodiscard]] bool empty() const { return m_entries.empty(); };
+
+		// radix passes the last sort() actually ran
+		[[nodiscard]] uint32_t getSortPassCount() const { return m_sortPassCount; };
+
+	private:
+		static constexpr uint32_t RADIX_BITS = 8;
+		static constexpr uint32_t RADIX = 1u << RADIX_BITS;
+
+		std::vector<Entry> m_entries;
+		std::vector<Entry> m_scratch;
+		// one histogram (then scatter offsets) per chunk
+		std::vector<std::array<uint32_t, RADIX>> m_histograms;
+		std::vector<uint64_t> m_chunkVarying;
+
+		uint32_t m_sortPassCount = 0;
+	};
+}
@@ -3,8 +3,12 @@
 #include <iostream>
 #include <memory>
 #include <glm/gtx/string_cast.hpp>
+#include "graphics/Mesh/MeshRenderSystem.h"
+#include "graphics/Renderer/FrameData.h"
 
 namespace SCENE { class Scene;	  };
+namespace core { class ThreadPool; };
+class World;
 
 namespace Graphics
 {
@@ -17,9 +21,27 @@ namespace Graphics
 		Renderer(const std::shared_ptr<RenderData>& renderData);
 		Renderer() = default;
 
-		void draw(std::shared_ptr<SCENE::Scene>& scene, const glm::mat4& view, const glm::mat4& projection) const;
+		// scene objects are World entities, drawn by the MeshRenderSystem
+		void draw(std::shared_ptr<SCENE::Scene>& scene);
+
+		// ECS entities (Transform + Mesh + Material), batched per shader/material/sub-mesh
+		void drawWorld(World& world);
+
+		// camera uniforms every shader reads, written at the start of each drawWorld()
+		[[nodiscard]] const Render::FrameData& getFrameData() const { return m_frameData.getData(); };
+
+		[[nodiscard]] const Render::MeshRenderSystem& getMeshRenderSystem() const { return m_meshRenderSystem; };
+		[[nodiscard]] Render::MeshRenderSystem& getMeshRenderSystem() { return m_meshRenderSystem; };
+
+		// worker pool for the parallel parts of drawing (frustum culling), not owned
+		void setThreadPool(core::ThreadPool* threadPool) { m_threadPool = threadPool; };
 
 	protected:
 		std::shared_ptr<RenderData> m_renderData;
+
+		core::ThreadPool* m_threadPool = nullptr;
+
+		Render::FrameDataBuffer m_frameData;
+		Render::MeshRenderSystem m_meshRenderSystem;
 	};
 }
@@ -3,6 +3,8 @@
 #include <vector>
 #include <glm/gtc/type_ptr.hpp>
 
+#include "core/NameId.h"
+
 namespace Graphics   { struct Material;     };
 namespace Graphics { class  RenderData;   };
 namespace LIGHTING   { class  Light;		};
@@ -13,6 +15,10 @@ namespace SHADER
 	// forward declaration
 	class GLShaderProgram;
 
+	// the instanced program (shaders/opengl/basic_instanced.vert/.frag) that scene objects and
+	// MeshRenderSystem fall back to, interned once instead of hashing the name on every lookup
+	extern const core::NameId DEFAULT_INSTANCED_SHADER;
+
 	enum class ShaderType
 	{
 		BASIC,
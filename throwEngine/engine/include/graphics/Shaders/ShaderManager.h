@@ -5,6 +5,8 @@
 #include <unordered_map>
 #include "nlohmann/json.hpp"
 
+#include "core/NameId.h"
+
 #include "graphics/Shaders/ShaderInterface.h"
 
 namespace SHADER
@@ -27,13 +29,14 @@ namespace SHADER
 
 		void addShaderInterface(const std::string& name, const std::shared_ptr<IShader>& shader);
 		std::shared_ptr<IShader> getShaderInterface(const std::string& name);
+		std::shared_ptr<IShader> getShaderInterface(core::NameId name);
 		std::vector<std::shared_ptr<IShader>> getAllShaderInterfaces();
 
 		void setWrapperGLShader(const std::shared_ptr<GLShaderProgram> wrapper) { m_wrapperShader = wrapper; };
 		std::shared_ptr<GLShaderProgram>& getWrapperGLShader() { return m_wrapperShader; };
 
 	private:
-		std::unordered_map<std::string, std::shared_ptr<IShader>> shaderInterfaces_;
+		std::unordered_map<core::NameId, std::shared_ptr<IShader>> shaderInterfaces_;
 		std::shared_ptr<GLShaderProgram> m_wrapperShader;
 	};
 }
@@ -1,11 +1,27 @@
 #pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 #include <glm/ext.hpp>
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
+#include "core/NameId.h"
+
 namespace SHADER {
 
+	// index into a program's reflected uniform table, invalid if the uniform doesn't exist or was optimized out.
+	// Handles are per program and stay valid for its lifetime
+	struct UniformHandle {
+		int32_t index = -1;
+
+		[[nodiscard]] bool isValid() const noexcept { return index >= 0; };
+	};
+
 	class GLShaderProgram
 	{
 	public:
@@ -20,6 +36,28 @@ namespace SHADER {
 
 		[[nodiscard]] uint32_t getProgramID() const noexcept;
 		[[nodiscard]] bool hasUniform(const std::string& name) const noexcept;
+		[[nodiscard]] bool hasUniform(core::NameId name) const noexcept;
+
+		// table lookups, no GL calls. Resolve once and keep the handle on hot paths
+		[[nodiscard]] UniformHandle getUniformHandle(core::NameId name) const noexcept;
+		[[nodiscard]] UniformHandle getUniformHandle(std::string_view name) const noexcept;
+
+		// reflected GL type (GL_FLOAT_VEC3, GL_SAMPLER_2D, ...), 0 for an invalid handle
+		[[nodiscard]] GLenum getUniformType(UniformHandle handle) const noexcept;
+		[[nodiscard]] size_t getUniformCount() const noexcept { return m_uniforms.size(); };
+
+		// skipped when the value equals the last one set through this program, or when the handle is invalid
+		// or its type doesn't take the value. Uses glProgramUniform*, the program doesn't have to be bound
+		void set(UniformHandle handle, bool value) const noexcept;
+		void set(UniformHandle handle, int value) const noexcept;
+		void set(UniformHandle handle, uint value) const noexcept;
+		void set(UniformHandle handle, float value) const noexcept;
+		void set(UniformHandle handle, const glm::vec2& value) const noexcept;
+		void set(UniformHandle handle, const glm::vec3& value) const noexcept;
+		void set(UniformHandle handle, const glm::vec4& value) const noexcept;
+		void set(UniformHandle handle, const glm::mat2& value) const noexcept;
+		void set(UniformHandle handle, const glm::mat3& value) const noexcept;
+		void set(UniformHandle handle, const glm::mat4& value) const noexcept;
 
 		void setUniform(const std::string& name, const glm::mat4& type) const;
 		void setUniforms(const glm::mat4& model, const glm::mat4& view, const glm::mat4& projection) const;
@@ -45,10 +83,30 @@ namespace SHADER {
 		[[nodiscard]] bool checkShaderCompilingErrors(const GLenum shaderType = 0, unsigned int shader = 0);
 
 	private:
+		struct Uniform {
+			GLint location = -1;
+			GLenum type = 0;
+			bool shadowValid = false;
+			// last value set, large enough for a mat4
+			alignas(16) std::array<std::byte, sizeof(glm::mat4)> shadow{};
+		};
+
+		// fills the uniform table from the linked program, array elements get one entry each
+		void reflectUniforms();
+		void addUniform(std::string_view name, GLint location, GLenum type);
+
+		// true when value has to be uploaded, updates the shadow copy
+		template<typename T>
+		[[nodiscard]] bool changed(UniformHandle handle, GLenum valueType, const T& value) const noexcept;
+
 		unsigned int m_vertexID, m_fragmentID;
 		unsigned int m_programID;
 
 		bool m_isValid;
+
+		// shadow copies change in const setters
+		mutable std::vector<Uniform> m_uniforms;
+		std::unordered_map<core::NameId, int32_t> m_uniformIndex;
 	};
 }
 
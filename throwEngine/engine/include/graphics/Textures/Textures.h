@@ -3,11 +3,12 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include "core/NameId.h"
 
 namespace Graphics
 {
 	struct Texture {
-		std::string name;
+		core::NameId name;
 		std::string path;
 		uint32_t glID = 0;
 		int width = 0;
@@ -23,15 +24,16 @@ namespace Graphics
 		uint32_t load(const std::string& name, const std::string& filePath, int width = 2, int height = 2, int nrChannels = 0);
 		void bind(uint32_t texID, uint32_t slot);
 
-		[[nodiscard]] bool hasTextureWithName(const std::string& name) const { return m_nameMap.contains(name); };
+		[[nodiscard]] bool hasTextureWithName(const std::string& name) const { return m_nameMap.contains(core::NameId::find(name)); };
 		[[nodiscard]] bool hasTextureWithPath(const std::string& path) const { return m_pathMap.contains(path); };
 
 		[[nodiscard]] std::shared_ptr<Texture> getTextureWithName(const std::string& name);
+		[[nodiscard]] std::shared_ptr<Texture> getTextureWithName(core::NameId name);
 		[[nodiscard]] std::shared_ptr<Texture> getTextureWithPath(const std::string& path);
 		[[nodiscard]] std::vector<std::shared_ptr<Texture>> getAllTextures() const;
 
 	private:
-		std::unordered_map<std::string, std::shared_ptr<Texture>> m_nameMap; // name -> texture (for UI stuff)
+		std::unordered_map<core::NameId, std::shared_ptr<Texture>> m_nameMap; // name -> texture (for UI stuff)
 		std::unordered_map<std::string, std::shared_ptr<Texture>> m_pathMap; // file path -> texture
 		std::vector<std::shared_ptr<Texture>> m_allTextures; // for iteration
 	};
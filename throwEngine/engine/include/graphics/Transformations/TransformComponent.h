@@ -2,10 +2,10 @@
 // Created by pointerlost on 8/7/25.
 //
 #pragma once
-#include <memory>
-
-class Transform;
+#include <cstdint>
+#include "graphics/Transformations/TransformPool.h"
 
+// handle into the Graphics::TransformPool (RenderData::getTransformPool), the data itself lives there in SoA form
 struct TransformComponent {
-    std::shared_ptr<Transform> transform;
+    uint32_t id = Graphics::TransformPool::INVALID_ID;
 };
@@ -0,0 +1,117 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+namespace core { class ThreadPool; };
+
+namespace Graphics
+{
+	/*
+	 * Structure-of-arrays transform storage, one float array per component
+	 * (position x/y/z, euler x/y/z, quaternion x/y/z/w, scale x/y/z) plus the world matrices.
+	 *
+	 * Setters only write the arrays and raise the slot's dirty flag. updateMatrices() walks the dirty
+	 * flags BLOCK_SIZE slots at a time and, for every block with a dirty slot, wraps the euler angles
+	 * in bulk, rebuilds quaternions of rotated slots and composes the local T * R * S for the whole
+	 * block with SIMD.
+	 *
+	 * Hierarchy: a transform can have a parent, its world matrix is parentWorld * local.
+	 * Transforms are kept in a depth-first order where every root's subtree is one contiguous range
+	 * (parents before children), so propagation is a linear pass per root, roots run in parallel,
+	 * and subtrees without a dirty node are skipped as a whole.
+	 * Ids are stable slot indices, destroyed slots are recycled. Not thread-safe, set from one thread.
+	 */
+	class TransformPool
+	{
+	public:
+		static constexpr uint32_t INVALID_ID = std::numeric_limits<uint32_t>::max();
+		static constexpr size_t BLOCK_SIZE = 8;
+
+		uint32_t create(const glm::vec3& position = glm::vec3(0.0f), const glm::vec3& eulerAngles = glm::vec3(0.0f),
+			const glm::vec3& scale = glm::vec3(1.0f));
+		// children of a destroyed transform become roots (their local matrix is kept)
+		void destroy(uint32_t id);
+		[[nodiscard]] bool isValid(uint32_t id) const { return id < m_alive.size() && m_alive[id]; };
+
+		// INVALID_ID detaches, false (and nothing changes) if it would create a cycle
+		bool setParent(uint32_t id, uint32_t parent);
+		[[nodiscard]] uint32_t getParent(uint32_t id) const { return m_parent[id]; };
+
+		void setPosition(uint32_t id, const glm::vec3& position);
+		// euler angles in degrees, wrapped to [0, 360) by the next updateMatrices()
+		void setRotation(uint32_t id, const glm::vec3& eulerAngles);
+		void setScale(uint32_t id, const glm::vec3& scale);
+
+		void addPosition(uint32_t id, const glm::vec3& offset) { setPosition(id, getPosition(id) + offset); };
+		void addRotation(uint32_t id, const glm::vec3& angles) { setRotation(id, getEulerAngles(id) + angles); };
+		void addScale(uint32_t id, const glm::vec3& s) { setScale(id, getScale(id) + s); };
+
+		[[nodiscard]] glm::vec3 getPosition(uint32_t id) const { return { m_posX[id], m_posY[id], m_posZ[id] }; };
+		[[nodiscard]] glm::vec3 getEulerAngles(uint32_t id) const { return { m_eulerX[id], m_eulerY[id], m_eulerZ[id] }; };
+		[[nodiscard]] glm::quat getRotation(uint32_t id) const { return { m_quatW[id], m_quatX[id], m_quatY[id], m_quatZ[id] }; };
+		[[nodiscard]] glm::vec3 getScale(uint32_t id) const { return { m_scaleX[id], m_scaleY[id], m_scaleZ[id] }; };
+
+		// up to date after updateMatrices()
+		[[nodiscard]] const glm::mat4& getLocalMatrix(uint32_t id) const { return m_localMatrices[id]; };
+		[[nodiscard]] const glm::mat4& getWorldMatrix(uint32_t id) const { return m_worldMatrices[id]; };
+		[[nodiscard]] const std::vector<glm::mat4>& getWorldMatrices() const { return m_worldMatrices; };
+		[[nodiscard]] bool isDirty(uint32_t id) const { return m_dirty[id] != 0; };
+		// the world matrix was changed by the last updateMatrices() (moved itself or an ancestor did)
+		[[nodiscard]] bool hasWorldChanged(uint32_t id) const { return m_worldChangedFrame[id] == m_frame; };
+
+		// recomputes every dirty local matrix and the world matrix of every dirty transform and of
+		// all their descendants, work is spread over threadPool when one is given.
+		// Returns how many world matrices changed.
+		size_t updateMatrices(core::ThreadPool* threadPool = nullptr);
+
+		[[nodiscard]] size_t getAliveCount() const { return m_aliveCount; };
+		// slot count, padded to BLOCK_SIZE
+		[[nodiscard]] size_t getCapacity() const { return m_alive.size(); };
+
+		void reserve(size_t capacity);
+
+	private:
+		void grow(size_t minCapacity);
+		void markDirty(uint32_t id);
+		void updateBlocks(size_t firstBlock, size_t lastBlock);
+		void composeBlock(size_t base);
+
+		void rebuildOrder();
+		size_t propagate(size_t firstRoot, size_t lastRoot);
+
+		std::vector<float> m_posX, m_posY, m_posZ;
+		std::vector<float> m_eulerX, m_eulerY, m_eulerZ;
+		std::vector<float> m_quatX, m_quatY, m_quatZ, m_quatW;
+		std::vector<float> m_scaleX, m_scaleY, m_scaleZ;
+
+		std::vector<glm::mat4> m_localMatrices;
+		std::vector<glm::mat4> m_worldMatrices;
+
+		std::vector<uint32_t> m_parent;
+		std::vector<uint32_t> m_childCount;
+		// set on a dirty slot and all its ancestors, lets propagation skip clean subtrees
+		std::vector<uint8_t> m_subtreeDirty;
+		// frame in which the world matrix last changed, children compare it with m_frame
+		std::vector<uint32_t> m_worldChangedFrame;
+		uint32_t m_frame = 0;
+
+		// depth-first order of alive slots, m_subtreeEnd[i] = one past the subtree of m_order[i]
+		std::vector<uint32_t> m_order;
+		std::vector<uint32_t> m_subtreeEnd;
+		// positions in m_order where a root starts
+		std::vector<uint32_t> m_rootStarts;
+		bool m_orderDirty = false;
+
+		// one byte per slot so a whole block is tested with a single 64-bit load
+		std::vector<uint8_t> m_dirty;
+		std::vector<uint8_t> m_rotationDirty;
+		std::vector<uint8_t> m_alive;
+
+		std::vector<uint32_t> m_freeIds;
+		size_t m_slotCount = 0;
+		size_t m_aliveCount = 0;
+	};
+}
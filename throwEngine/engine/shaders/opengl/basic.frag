@@ -25,7 +25,17 @@ uniform Light lights[64];
 uniform vec3 globalAmbient;
 uniform bool isItLightVisualObject;
 
-uniform vec3 viewPos;
+// per-frame camera data, written once per frame by Render::FrameDataBuffer (keep in sync with Render::FrameData)
+layout (std140, binding = 0) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+    mat4 inverseView;
+    mat4 inverseProjection;
+    mat4 inverseViewProjection;
+    vec4 cameraPosition; // w = time in seconds
+    vec4 viewport;       // xy = size in pixels, zw = 1 / size
+};
 
 struct Material {
     vec3 ambient;
@@ -47,7 +57,7 @@ vec3 calcLightProperties(uint index, Material material, vec3 normal) {
     vec3 diffuse = diff * lights[index].diffuse * material.diffuse;
 
     // specular
-    vec3 viewDir = normalize(viewPos - FragPos);
+    vec3 viewDir = normalize(cameraPosition.xyz - FragPos);
     vec3 reflectDir = reflect(-lightDir, norm);
     float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
     vec3 specular = lights[index].specular * spec * material.specular;
@@ -6,8 +6,18 @@ layout (location = 2) in vec3 aColor; // for debugging visuals or
 layout (location = 3) in vec2 aTexCoords;
 
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+
+// per-frame camera data, written once per frame by Render::FrameDataBuffer (keep in sync with Render::FrameData)
+layout (std140, binding = 0) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+    mat4 inverseView;
+    mat4 inverseProjection;
+    mat4 inverseViewProjection;
+    vec4 cameraPosition; // w = time in seconds
+    vec4 viewport;       // xy = size in pixels, zw = 1 / size
+};
 
 out vec3 FragPos;
 out vec3 Normal;
@@ -21,5 +31,5 @@ void main()
     Color       = aColor;
     TexCoords   = aTexCoords;
 
-    gl_Position = projection * view * vec4(FragPos, 1.0);
+    gl_Position = viewProjection * vec4(FragPos, 1.0);
 }
\ No newline at end of file
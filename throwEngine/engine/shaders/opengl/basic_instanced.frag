@@ -0,0 +1,87 @@
+#version 440 core
+
+out vec4 FragColor;
+
+// take inputs from vertex shader
+in vec3 FragPos;
+in vec3 Normal;
+in vec3 Color;
+in vec2 TexCoords;
+flat in uint MaterialIndex;
+
+uniform uint activeLightCount;
+
+// Scene Lighting stuff
+struct Light {
+    vec3 position;
+    vec3 direction;
+
+    vec3 diffuse;
+    vec3 specular;
+
+    // int type;
+};
+uniform Light lights[64];
+
+uniform vec3 globalAmbient;
+uniform bool isItLightVisualObject;
+
+// per-frame camera data, written once per frame by Render::FrameDataBuffer (keep in sync with Render::FrameData)
+layout (std140, binding = 0) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+    mat4 inverseView;
+    mat4 inverseProjection;
+    mat4 inverseViewProjection;
+    vec4 cameraPosition; // w = time in seconds
+    vec4 viewport;       // xy = size in pixels, zw = 1 / size
+};
+
+struct Material {
+    vec3 ambient;
+    vec3 diffuse;
+    vec3 specular;
+
+    float shininess;
+};
+
+// every material drawn this frame, written by Render::MeshRenderSystem (std430, vec3s padded to vec4)
+struct MaterialData {
+    vec4 ambient;
+    vec4 diffuse;
+    vec4 specular; // w = shininess
+};
+layout (std430, binding = 0) readonly buffer Materials {
+    MaterialData materials[];
+};
+
+vec3 calcLightProperties(uint index, Material material, vec3 normal) {
+    // ambient
+    vec3 ambient = globalAmbient * material.ambient;
+
+    // diffuse
+    vec3 norm = normalize(normal);
+    vec3 lightDir = normalize(lights[index].position - FragPos);
+    float diff = max(dot(norm, lightDir), 0.0);
+    vec3 diffuse = diff * lights[index].diffuse * material.diffuse;
+
+    // specular
+    vec3 viewDir = normalize(cameraPosition.xyz - FragPos);
+    vec3 reflectDir = reflect(-lightDir, norm);
+    float spec = pow(max(dot(viewDir, reflectDir), 0.0), material.shininess);
+    vec3 specular = lights[index].specular * spec * material.specular;
+
+    return ambient + diffuse + specular;
+}
+
+void main() {
+    MaterialData data = materials[MaterialIndex];
+    Material material = Material(data.ambient.xyz, data.diffuse.xyz, data.specular.xyz, data.specular.w);
+
+    vec3 result = vec3(0.0);
+    for (uint i = 0; i < activeLightCount; i++) {
+        result += calcLightProperties(i, material, Normal);
+    }
+    FragColor = vec4(result, 1.0f);
+}
@@ -0,0 +1,42 @@
+#version 440 core
+
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+layout (location = 2) in vec3 aColor; // for debugging visuals or
+layout (location = 3) in vec2 aTexCoords;
+
+// per instance, written by Render::MeshRenderSystem. Matrices take one location per column
+layout (location = 4) in mat4 aModel;
+// transpose(inverse(mat3(aModel))), computed once per instance on the CPU
+layout (location = 8) in mat3 aNormalMatrix;
+// into the material buffer of basic_instanced.frag
+layout (location = 11) in uint aMaterialIndex;
+
+// per-frame camera data, written once per frame by Render::FrameDataBuffer (keep in sync with Render::FrameData)
+layout (std140, binding = 0) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    mat4 viewProjection;
+    mat4 inverseView;
+    mat4 inverseProjection;
+    mat4 inverseViewProjection;
+    vec4 cameraPosition; // w = time in seconds
+    vec4 viewport;       // xy = size in pixels, zw = 1 / size
+};
+
+out vec3 FragPos;
+out vec3 Normal;
+out vec3 Color;
+out vec2 TexCoords;
+flat out uint MaterialIndex;
+
+void main()
+{
+    FragPos     = vec3(aModel * vec4(aPos, 1.0));
+    Normal      = aNormalMatrix * aNormal;
+    Color       = aColor;
+    TexCoords   = aTexCoords;
+    MaterialIndex = aMaterialIndex;
+
+    gl_Position = viewProjection * vec4(FragPos, 1.0);
+}
\ No newline at end of file
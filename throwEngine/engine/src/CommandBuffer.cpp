@@ -0,0 +1,91 @@
+#include "CommandBuffer.h"
+
+#include <stdexcept>
+#include <string>
+#include "core/Logger.h"
+#include "core/ThreadPool.h"
+
+bool CommandBuffer::empty() const {
+    if (m_createCount != 0 || !m_deletes.empty()) return false;
+
+    return std::ranges::all_of(m_queues, [](const auto& queue) { return !queue || queue->empty(); });
+}
+
+void CommandBuffer::clear() {
+    m_createCount = 0;
+    m_deletes.clear();
+    for (auto& queue : m_queues) {
+        if (queue) queue->clear();
+    }
+}
+
+CommandBuffer& CommandBuffers::local() {
+    const uint32_t index = core::ThreadPool::getWorkerIndex();
+    if (index >= m_buffers.size()) {
+        Logger::error("[CommandBuffers::local] no command buffer for worker " + std::to_string(index));
+        throw std::out_of_range("[CommandBuffers::local] worker index out of range");
+    }
+    return m_buffers[index];
+}
+
+bool CommandBuffers::empty() const {
+    return std::ranges::all_of(m_buffers, [](const CommandBuffer& buffer) { return buffer.empty(); });
+}
+
+void CommandBuffers::playback(World& world) {
+    // creates: every pending entity gets its real handle, buffer by buffer
+    size_t createCount = 0;
+    size_t typeCount = 0;
+    for (const auto& buffer : m_buffers) {
+        createCount += buffer.m_createCount;
+        typeCount = std::max(typeCount, buffer.m_queues.size());
+    }
+    world.reserveEntities(createCount);
+
+    std::vector<std::vector<Entity>> created(m_buffers.size());
+    for (size_t i = 0; i < m_buffers.size(); ++i) {
+        created[i].reserve(m_buffers[i].m_createCount);
+        for (uint32_t n = 0; n < m_buffers[i].m_createCount; ++n) {
+            created[i].push_back(world.createEntity());
+        }
+    }
+
+    // adds, then removes: one batch per component type, merged across every buffer
+    std::vector<CommandSource> sources;
+    const auto collectSources = [&](size_t type) {
+        sources.clear();
+        for (size_t i = 0; i < m_buffers.size(); ++i) {
+            const auto& queues = m_buffers[i].m_queues;
+            if (type < queues.size() && queues[type] && !queues[type]->empty()) {
+                sources.push_back(CommandSource{ queues[type].get(), &created[i] });
+            }
+        }
+        return !sources.empty();
+    };
+
+    for (size_t type = 0; type < typeCount; ++type) {
+        if (collectSources(type)) sources.front().queue->playbackAdds(world, sources);
+    }
+    for (size_t type = 0; type < typeCount; ++type) {
+        if (collectSources(type)) sources.front().queue->playbackRemoves(world, sources);
+    }
+
+    // destroys last, duplicates (two threads destroying the same entity) collapse into one
+    std::vector<Entity> deletes;
+    for (const auto& buffer : m_buffers) {
+        deletes.insert(deletes.end(), buffer.m_deletes.begin(), buffer.m_deletes.end());
+    }
+    std::ranges::sort(deletes, [](Entity a, Entity b) {
+        return std::pair(ECS::getIndex(a), a) < std::pair(ECS::getIndex(b), b);
+    });
+    const auto duplicates = std::ranges::unique(deletes);
+    deletes.erase(duplicates.begin(), duplicates.end());
+
+    for (const Entity e : deletes) {
+        if (world.isAlive(e)) world.deleteEntity(e);
+    }
+
+    for (auto& buffer : m_buffers) {
+        buffer.clear();
+    }
+}
@@ -12,8 +12,6 @@
 
 #include "graphics/Lighting/LightManager.h"
 
-#include <graphics/Transformations/Transformations.h>
-
 #include "Scene/Scene.h"
 
 #include "Scene/SceneObject.h"
@@ -69,8 +67,6 @@ namespace ENGINE::UI
 
 		const auto lightCount = m_renderData->getLightManager()->getActiveLightCount();
 
-		const auto sceneObjects = scene->getSceneObjectVec();
-
 		ImGuiIO& io = ImGui::GetIO();
 
 		if (const ImGuiScopedWindow addButton("Add Object"); addButton)
@@ -102,13 +98,14 @@ namespace ENGINE::UI
 			if (ImGui::Button("Delete Object")) {
 				const auto& lightManager = m_renderData->getLightManager();
 
-				for (const auto& sceneObject : sceneObjects) {
-					if (!sceneObject) continue;
-					const std::string& name = sceneObject->getName();
-					if (m_objectUIStates[name].isOpen) {
-						scene->markToBeDeleted(name);
-						if (lightManager->checkLightExists(name)) lightManager->removeLight(name);
+				for (auto it = m_objectUIStates.begin(); it != m_objectUIStates.end();) {
+					const auto& [handle, state] = *it;
+					if (state.isOpen) {
+						scene->markToBeDeleted(handle);
+						if (lightManager->checkLightExists(handle)) lightManager->removeLight(handle);
+						it = m_objectUIStates.erase(it);
 					}
+					else ++it;
 				}
 			}
 		}
@@ -133,9 +130,9 @@ namespace ENGINE::UI
 	{
 		generalMenuForPanel();
 
-		sceneObjectSelectionPanel(scene->getSceneObjectVec());
+		sceneObjectSelectionPanel(*scene);
 
-		implForRenderObjects(scene->getSceneObjectVec());
+		implForRenderObjects(*scene);
 
 		lightingPanelWindow();
 
@@ -195,47 +192,58 @@ namespace ENGINE::UI
 		currentLight->update(currentLight);
 	}
 
-	void ImGuiLayer::implForRenderObjects(std::vector<std::shared_ptr<SCENE::SceneObject>>& sceneObjects)
+	void ImGuiLayer::implForRenderObjects(SCENE::Scene& scene)
 	{
-		for (auto& obj : sceneObjects)
+		// only the open windows are visited, not every object of the scene
+		for (auto it = m_objectUIStates.begin(); it != m_objectUIStates.end();)
 		{
-			if (!obj) return;
-			const std::string& name = obj->getName();
-			auto& state = m_objectUIStates[name];
+			auto& [handle, state] = *it;
+
+			// the object was destroyed somewhere else, its handle went stale
+			if (!scene.isAlive(handle)) {
+				it = m_objectUIStates.erase(it);
+				continue;
+			}
+			++it;
 
 			if (!state.isOpen) continue;
 
+			auto obj = scene.getObject(handle);
+
 			ImGui::SetNextWindowSize(ImVec2(400, 300));
 
-			if (const ImGuiScopedWindow objectWindow((name + std::string(" | Object Properties")).c_str(), &state.isOpen); objectWindow)
+			// "##index" keeps the window ID unique for unnamed objects
+			const std::string title = obj.getName() + " | Object Properties##" + std::to_string(handle.index);
+			if (const ImGuiScopedWindow objectWindow(title.c_str(), &state.isOpen); objectWindow)
 			{
-				showSelectedObjectProperties(obj);
+				showSelectedObjectProperties(obj, state);
 			}
 		}
 	}
 
-	void ImGuiLayer::sceneObjectSelectionPanel(const std::vector<std::shared_ptr<SCENE::SceneObject>>& sceneObjects)
+	void ImGuiLayer::sceneObjectSelectionPanel(SCENE::Scene& scene)
 	{
 		if (!m_showObjectListWindow) return;
 
-		const uint32_t objectsSize = sceneObjects.size();
+		const uint32_t objectsSize = scene.getObjectCount();
 
 		ImGui::SetNextWindowSize(ImVec2(200, static_cast<float>(objectsSize * 35)), ImGuiCond_Once);
 
 		// ImGuiScopedWindow is a RAII wrapper for ImGui::Begin() and ImGui::End()
 		if (const ImGuiScopedWindow objectList("Scene Objects", &m_showObjectListWindow); objectList)
 		{
-			for (auto& obj : sceneObjects)
+			scene.forEachObject([&](const SCENE::SceneObject& obj)
 			{
-				if (!obj) return;
-				const std::string name = obj->getName();
-				auto& state = m_objectUIStates[name];
+				ImGui::PushID(static_cast<int>(obj.getHandle().index));
 
-				if (ImGui::Selectable(name.c_str()))
+				if (ImGui::Selectable(obj.getName().empty() ? "(unnamed)" : obj.getName().c_str()))
 				{
+					auto& state = m_objectUIStates[obj.getHandle()];
 					state.isOpen = !state.isOpen;
 				}
-			}
+
+				ImGui::PopID();
+			});
 		}
 	}
 
@@ -251,7 +259,7 @@ namespace ENGINE::UI
 		}
 	}
 
-	void ImGuiLayer::showTransformProperties(std::shared_ptr<SCENE::SceneObject>& object, UIObjectState& state)
+	void ImGuiLayer::showTransformProperties(SCENE::SceneObject& object, UIObjectState& state)
 	{
 		if (const ImGuiScopedMenu transformProperties("TRANSFORMATIONS"); transformProperties) {
 			if (ImGui::IsItemHovered())
@@ -267,7 +275,7 @@ namespace ENGINE::UI
 		}
 	}
 
-	void ImGuiLayer::showMaterialProperties(std::shared_ptr<SCENE::SceneObject>& object, UIObjectState& state)
+	void ImGuiLayer::showMaterialProperties(SCENE::SceneObject& object, UIObjectState& state)
 	{
 		if (const ImGuiScopedMenu materialProperties("Graphics"); materialProperties) {
 			if (ImGui::IsItemHovered())
@@ -283,10 +291,8 @@ namespace ENGINE::UI
 		}
 	}
 
-	void ImGuiLayer::showSelectedObjectProperties(std::shared_ptr<SCENE::SceneObject>& object)
+	void ImGuiLayer::showSelectedObjectProperties(SCENE::SceneObject& object, UIObjectState& state)
 	{
-		auto& state = m_objectUIStates[object->getName()];
-
 		// push style variables to change padding
 		ImGuiScopedStyleVar stylePadding(ImGuiStyleVar_FramePadding, ImVec2(15, 12));
 
@@ -295,10 +301,11 @@ namespace ENGINE::UI
 		showTransformProperties(object, state);
 	}
 
-	void ImGuiLayer::setSceneObjectMaterial(const std::shared_ptr<SCENE::SceneObject>& sceneObject)
+	void ImGuiLayer::setSceneObjectMaterial(SCENE::SceneObject& sceneObject)
 	{
-		const auto object = sceneObject->getShaderInterface();
-		const auto& material = sceneObject->getMaterialInstance();
+		const auto object = sceneObject.getShaderInterface();
+		// the object's own copy, editing it doesn't change the other objects using the same library material
+		const auto material = sceneObject.getEditableMaterial();
 
 		if (!object || !material) {
 			Logger::warn("[ImGuiLayer::setSceneObjectMaterial]: Scene Object has no material specified");
@@ -332,23 +339,20 @@ namespace ENGINE::UI
 
 		// ImGui::Checkbox("Enable diffuse  texture", &material->m_diffuseTexture);
 		// ImGui::Checkbox("Enable specular texture", &material->m_specularTexture);
-
-		sceneObject->setMaterialInstance(material);
 	}
 
-	void ImGuiLayer::setSceneObjectTransform(const std::shared_ptr<SCENE::SceneObject>& sceneObject)
+	void ImGuiLayer::setSceneObjectTransform(SCENE::SceneObject& sceneObject)
 	{
-		ImGui::PushID(sceneObject->getName().c_str()); // Push a unique ID for the object
-
-		const auto &transform = sceneObject->getTransform();
-		if (!transform) {
-			Logger::error("[ImGuiLayer::setSceneObjectTransform] Transform is nullptr!");
+		if (!sceneObject) {
+			Logger::error("[ImGuiLayer::setSceneObjectTransform] SceneObject is not valid!");
 			return;
 		}
 
-		auto position = transform->getPosition();
-		auto angles   = transform->getEulerAngles();
-		auto scale	  = transform->getScale();
+		ImGui::PushID(static_cast<int>(sceneObject.getHandle().index)); // Push a unique ID for the object
+
+		auto position = sceneObject.getPosition();
+		auto angles   = sceneObject.getEulerAngles();
+		auto scale	  = sceneObject.getScale();
 
 		ImGui::Text("Position");
 		ImGui::SliderFloat("X##Position", &position.x, -100.0, 100.0);
@@ -369,8 +373,10 @@ namespace ENGINE::UI
 		ImGui::SliderFloat("Y##Scale", &scale.y, 0.01, 10.0);
 		ImGui::SliderFloat("Z##Scale", &scale.z, 0.01, 10.0);
 
-		// Update the transform with the new values
-		transform->updateAll(angles, position, scale);
+		// Update the transform with the new values, the world matrix is rebuilt by the next TransformPool::updateMatrices
+		sceneObject.setPosition(position);
+		sceneObject.setRotation(angles);
+		sceneObject.setScale(scale);
 
 		// lightData should set position to a visual object
 
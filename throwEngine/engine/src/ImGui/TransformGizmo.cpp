@@ -3,7 +3,6 @@
 //
 #include "ImGui/TransformGizmo.h"
 #include <Scene/SceneObject.h>
-#include <graphics/Transformations/Transformations.h>
 
 namespace ENGINE::UI
 {
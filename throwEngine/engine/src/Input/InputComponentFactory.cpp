@@ -4,22 +4,22 @@
 
 #include <core/Logger.h>
 
-#include <graphics/Transformations/Transformations.h>
+#include <Scene/SceneObject.h>
 
 #include <graphics/Lighting/Light.h>
 
 namespace Input
 {
-	std::shared_ptr<IInputComponent> InputComponentFactory::createObjectComponent(InputType type, std::shared_ptr<Graphics::Transform> transform)
+	std::shared_ptr<IInputComponent> InputComponentFactory::createObjectComponent(InputType type, const SCENE::SceneObject& object)
 	{
 		Input::InputContext context{};
 
 		switch (type)
 		{
 		case InputType::CubeInputComponent:
-			return std::make_shared<CubeInputComponent>(transform, context);
+			return std::make_shared<CubeInputComponent>(object, context);
 		case InputType::SphereInputComponent:
-			return std::make_shared<SphereInputComponent>(transform, context);
+			return std::make_shared<SphereInputComponent>(object, context);
 		default:
 			Logger::error("Unknown input component type: " + std::to_string(static_cast<int>(type)));
 			return nullptr;
@@ -28,11 +28,11 @@ namespace Input
 
 	std::shared_ptr<IInputComponent> InputComponentFactory::createLightComponent(
 		InputType type,
-		std::shared_ptr<Graphics::Transform> transform,
+		const SCENE::SceneObject& object,
 		std::shared_ptr<LIGHTING::Light>& light)
 	{
 		Input::InputContext context{};
 	
-		return std::make_shared<LightInputComponent>(transform, context, light);
+		return std::make_shared<LightInputComponent>(object, context, light);
 	}
 } // namespace Input
\ No newline at end of file
@@ -0,0 +1,85 @@
+#include "Math/Frustum.h"
+
+#include <cmath>
+
+#include "Math/SIMD.h"
+
+namespace MATH {
+
+    Frustum Frustum::fromViewProjection(const glm::mat4 &viewProjection) {
+        // glm is column major, m[column][row]
+        const auto row = [&viewProjection](int r) {
+            return glm::vec4(viewProjection[0][r], viewProjection[1][r], viewProjection[2][r], viewProjection[3][r]);
+        };
+        const glm::vec4 x = row(0), y = row(1), z = row(2), w = row(3);
+
+        Frustum frustum;
+        frustum.planes = { w + x, w - x, w + y, w - y, w + z, w - z };
+        for (auto& plane : frustum.planes) {
+            const float length = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+            if (length > 0.0f) plane = plane * (1.0f / length);
+        }
+        return frustum;
+    }
+
+    bool Frustum::intersects(const AABB &box) const {
+        const glm::vec3 center = box.getCenter();
+        const glm::vec3 extents = box.getExtents();
+        for (const auto& plane : planes) {
+            // projected radius of the box on the plane normal
+            const float radius = std::abs(plane.x) * extents.x + std::abs(plane.y) * extents.y + std::abs(plane.z) * extents.z;
+            const float distance = plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w;
+            if (distance + radius < 0.0f) return false;
+        }
+        return true;
+    }
+
+    size_t cullAABBs(const Frustum &frustum,
+                     const float *centerX, const float *centerY, const float *centerZ,
+                     const float *extentX, const float *extentY, const float *extentZ,
+                     size_t count, uint8_t *visible) {
+        using SIMD::Lanes;
+
+        // plane coefficients broadcast once, |normal| for the projected radius
+        struct PlaneLanes { Lanes nx, ny, nz, d, ax, ay, az; };
+        std::array<PlaneLanes, 6> planes;
+        for (size_t p = 0; p < planes.size(); ++p) {
+            const glm::vec4& plane = frustum.planes[p];
+            planes[p] = {
+                Lanes::set(plane.x), Lanes::set(plane.y), Lanes::set(plane.z), Lanes::set(plane.w),
+                Lanes::set(std::abs(plane.x)), Lanes::set(std::abs(plane.y)), Lanes::set(std::abs(plane.z)),
+            };
+        }
+        const Lanes zero = Lanes::set(0.0f);
+
+        size_t visibleCount = 0;
+        size_t i = 0;
+        for (; i + Lanes::WIDTH <= count; i += Lanes::WIDTH) {
+            const Lanes cx = Lanes::load(centerX + i), cy = Lanes::load(centerY + i), cz = Lanes::load(centerZ + i);
+            const Lanes ex = Lanes::load(extentX + i), ey = Lanes::load(extentY + i), ez = Lanes::load(extentZ + i);
+
+            // a lane is culled as soon as one plane has the whole box behind it
+            Lanes outside = lessThan(zero, zero);
+            for (const auto& plane : planes) {
+                const Lanes distance = plane.nx * cx + plane.ny * cy + plane.nz * cz + plane.d;
+                const Lanes radius = plane.ax * ex + plane.ay * ey + plane.az * ez;
+                outside = outside | lessThan(distance + radius, zero);
+            }
+
+            const int outsideMask = outside.mask();
+            for (size_t lane = 0; lane < Lanes::WIDTH; ++lane) {
+                const uint8_t isVisible = (outsideMask >> lane & 1) == 0;
+                visible[i + lane] = isVisible;
+                visibleCount += isVisible;
+            }
+        }
+
+        for (; i < count; ++i) {
+            const glm::vec3 center(centerX[i], centerY[i], centerZ[i]);
+            const glm::vec3 extents(extentX[i], extentY[i], extentZ[i]);
+            visible[i] = frustum.intersects({ center - extents, center + extents });
+            visibleCount += visible[i];
+        }
+        return visibleCount;
+    }
+}
@@ -5,6 +5,8 @@
 
 #include <cmath>
 
+#include "Math/SIMD.h"
+
 
 namespace MATH {
 
@@ -17,4 +19,19 @@ namespace MATH {
         }
         return wrapped;
     }
+
+    void wrapAnglesBulk(float* angles, size_t count) {
+        using SIMD::Lanes;
+
+        // a - 360 * floor(a / 360), same [0, 360) result as the fmod version
+        const Lanes fullTurn = Lanes::set(360.f);
+        size_t i = 0;
+        for (; i + Lanes::WIDTH <= count; i += Lanes::WIDTH) {
+            const Lanes a = Lanes::load(angles + i);
+            (a - fullTurn * floor(a / fullTurn)).store(angles + i);
+        }
+        for (; i < count; ++i) {
+            angles[i] -= 360.f * std::floor(angles[i] / 360.f);
+        }
+    }
 }
@@ -0,0 +1,33 @@
+#include "Math/SIMD.h"
+
+#if defined(THROW_SIMD_AVX_KERNELS) && defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+// never built with AVX, this has to run on any CPU
+namespace MATH::SIMD {
+
+    size_t kernelWidth() {
+#if defined(THROW_SIMD_AVX_KERNELS)
+        return 8;
+#else
+        return Lanes::WIDTH;
+#endif
+    }
+
+    bool kernelsSupported() {
+#if !defined(THROW_SIMD_AVX_KERNELS)
+        return true;
+#elif defined(_MSC_VER)
+        // CPUID.1:ECX bit 28 is AVX, bit 27 OSXSAVE, and the OS has to save the YMM registers (XCR0 bits 1 and 2)
+        int info[4];
+        __cpuid(info, 1);
+        if ((info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0) return false;
+        return (_xgetbv(0) & 0x6) == 0x6;
+#else
+        // also checks that the OS saves the YMM registers
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx");
+#endif
+    }
+}
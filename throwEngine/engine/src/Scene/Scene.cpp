@@ -12,7 +12,13 @@
 
 #include "graphics/Grid/GridSystem.h"
 
-#include <graphics/Transformations/Transformations.h>
+#include "graphics/Transformations/TransformComponent.h"
+#include "graphics/Transformations/TransformPool.h"
+
+#include "graphics/Mesh/MeshComponent.h"
+#include "graphics/Mesh/MeshData3D.h"
+
+#include "graphics/Material/MaterialComponent.h"
 
 #include "graphics/Lighting/LightManager.h"
 
@@ -32,31 +38,23 @@
 #include "core/Debug.h"
 #define DEBUG_PTR(ptr) DEBUG::DebugForEngineObjectPointers(ptr)
 
-namespace SCENE
+namespace
 {
-	Scene::Scene(const std::shared_ptr<Graphics::MeshData3D> &data3D, Input::InputContext context)
-		:meshData3D(data3D), inputContext(context)
+	template<typename... Ts>
+	void reserveComponents(World& world, size_t count)
 	{
-		DEBUG_PTR(meshData3D);
+		(world.getStorage<Ts>().reserve(world.getStorage<Ts>().size() + count), ...);
 	}
+}
 
-	void Scene::debugDrawing(const glm::mat4& view, const glm::mat4& projection, const std::shared_ptr<Graphics::RenderData>& renderData)
+namespace SCENE
+{
+	Scene::Scene(World& world, const std::shared_ptr<Graphics::TransformPool>& transformPool,
+		const std::shared_ptr<Graphics::MeshData3D>& data3D, Input::InputContext context)
+		:m_world(world), m_transformPool(transformPool), meshData3D(data3D), inputContext(context)
 	{
-		//DEBUG MODE
-		for (auto& obj : m_sceneObjectsVec) {
-			try {
-				if (obj) {
-					obj->draw(view, projection, renderData);
-				}
-				else {
-					throw std::runtime_error("trying to draw an object that returns nullptr!");
-					// using throw can be costly (especially in per-frame loops)
-				}
-			}
-			catch (const std::exception& e) {
-				Logger::error("Error drawing object " + obj->getName() + ": " + e.what());
-			}
-		}
+		DEBUG_PTR(m_transformPool);
+		DEBUG_PTR(meshData3D);
 	}
 
 	void Scene::initGrid(const std::shared_ptr<Graphics::RenderData>& renderData) const
@@ -89,149 +87,239 @@ namespace SCENE
 		Logger::info("[Scene::initGrid] successful!");
 	}
 
-	void Scene::drawGrid(const glm::mat4& view, const glm::mat4& projection, const std::shared_ptr<Graphics::RenderData>& renderData)
+	void Scene::drawGrid(const std::shared_ptr<Graphics::RenderData>& renderData)
 	{
 		if (const auto gridRenderer = renderData->getGridRenderer()) {
 			if (const auto shader = gridRenderer->getGridShader()) {
 				if (const auto shaderProgram = shader->getGLShaderProgram()) {
-					shaderProgram->bind();
-					shaderProgram->setMat4("u_view", view);
-					shaderProgram->setMat4("u_projection", projection);
 					gridRenderer->draw();
 				}
 			}
 		}
 	}
 
-	void Scene::drawAllObjects(const glm::mat4& view, const glm::mat4& projection, const std::shared_ptr<Graphics::RenderData>& renderData)
+	SceneHandle Scene::createObjectProperties(const SceneObjectDesc& desc)
 	{
-		if (!renderData) {
-			Logger::warn("[Scene::drawAllObjects] renderData is nullptr!");
-			return;
+		if (desc.name.isValid() && m_nameIndex.contains(desc.name)) {
+			Logger::warn("[Scene::createObjectProperties] name is already taken: " + desc.name.str() + " — skipping creation.");
+			return {};
 		}
 
-		for (const auto& obj : m_sceneObjectsVec)
-		{
-			if (!obj) {
-				Logger::error("[Scene::drawAllObjects] a scene object was nullptr, skipping draw!");
-				continue;
-			}
-			obj->draw(view, projection, renderData);
+		const Entity entity = addObject(desc, desc.position, nullptr);
+		if (entity == ECS::NullEntity) return {};
+
+		// Save the entity for lookup by name, unnamed objects are only reachable through their handle
+		if (desc.name.isValid()) {
+			m_nameIndex.emplace(desc.name, entity);
 		}
-		cleanUp();
-	}
 
-	uint32_t Scene::uniqueObjectIDGenerator()
-	{
-		static uint32_t uniqueID = 0;
-		return uniqueID++;
+		return SceneHandle::fromEntity(entity);
 	}
 
-	void Scene::createObjectProperties(const std::shared_ptr<SceneObject>& sceneObject)
+	std::vector<SceneHandle> Scene::createObjects(const SceneObjectDesc& prototype, std::span<const glm::vec3> positions)
 	{
-		uint32_t uniqueID{};
-		if (!sceneObject) {
-			Logger::warn("[Scene::createObjectProperties] Null SceneObject passed — skipping creation.");
-			return;
+		SceneObjectDesc unnamed = prototype;
+		if (unnamed.name.isValid()) {
+			Logger::warn("[Scene::createObjects] bulk objects are unnamed, ignoring name " + unnamed.name.str());
+			unnamed.name = {};
 		}
 
-		// Reuse an ID if available
-		if (m_freeIDs.empty()) {
-			uniqueID = uniqueObjectIDGenerator();
-		} else {
-			uniqueID = m_freeIDs.top();
-			m_freeIDs.pop();
-		}
+		const size_t count = positions.size();
+		std::vector<SceneHandle> handles;
+		handles.reserve(count);
 
-		// assign uniqueID to object itself
-		sceneObject->setID(uniqueID);
+		// one reallocation per container for the whole batch instead of a growth step every few objects
+		m_world.reserveEntities(count);
+		reserveComponents<NameComponent, TransformComponent, MeshComponent, MaterialComponent, SpatialProxyComponent>(m_world, count);
+		m_transformPool->reserve(m_transformPool->getAliveCount() + count);
 
-		uint32_t assignedIndex{};
+		const Graphics::SubMeshInfo* subMesh = meshData3D ? meshData3D->findObjectInfo(prototype.subMeshName) : nullptr;
 
-		if (m_freeIndicesStack.empty()) {
-			// No free slots use push_back
-			assignedIndex = static_cast<uint32_t>(m_sceneObjectsVec.size());
-			m_sceneObjectsVec.push_back(sceneObject);
-		} else {
-			// Reuse a free slot
-			assignedIndex = m_freeIndicesStack.top();
-			m_sceneObjectsVec[assignedIndex] = sceneObject;
-			m_freeIndicesStack.pop();
+		for (const glm::vec3& position : positions) {
+			const Entity entity = addObject(unnamed, position, subMesh);
+			if (entity == ECS::NullEntity) break;
+			handles.push_back(SceneHandle::fromEntity(entity));
 		}
+		return handles;
+	}
 
-		// Save the index for fast lookup by name
-		m_nameIndexHash[sceneObject->getName()] = assignedIndex;
+	Entity Scene::addObject(const SceneObjectDesc& desc, const glm::vec3& position, const Graphics::SubMeshInfo* subMesh)
+	{
+		// NullEntity once the World's index space is exhausted (it logs that itself)
+		const Entity entity = m_world.createEntity();
+		if (entity == ECS::NullEntity) return entity;
+
+		m_world.addComponent(entity, NameComponent{ desc.name });
+		m_world.addComponent(entity, TransformComponent{ m_transformPool->create(position, desc.eulerAngles, desc.scale) });
+		m_world.addComponent(entity, MeshComponent{ .meshData = meshData3D, .subMeshName = desc.subMeshName, .subMesh = subMesh });
+		m_world.addComponent(entity, MaterialComponent{ .material = desc.material, .shader = desc.shader });
+		// inserted into its spatial structure by updateSpatialIndex once its world matrix is computed
+		m_world.addComponent(entity, SpatialProxyComponent{ .mobility = desc.mobility });
+
+		++m_objectCount;
+		return entity;
+	}
 
-		// Save in ID->Object map
-		m_sceneObjectsMap[uniqueID] = sceneObject;
+	void Scene::markToBeDeleted(SceneHandle handle) {
+		if (isAlive(handle)) {
+			m_markForDeletion.push_back(handle.toEntity());
+		}
 	}
 
-	void Scene::markToBeDeleted(const std::string &name) {
-		m_markForDeletion.push(name);
+	void Scene::markToBeDeleted(core::NameId name) {
+		if (const auto it = m_nameIndex.find(name); it != m_nameIndex.end()) {
+			m_markForDeletion.push_back(it->second);
+		}
 	}
 
 	void Scene::cleanUp() {
-		while (!m_markForDeletion.empty()) {
-			destroyObject(m_markForDeletion.top());
-			m_markForDeletion.pop();
+		// the same object can be marked twice, the generation check skips the second one
+		for (const Entity entity : m_markForDeletion) {
+			if (m_world.isAlive(entity)) {
+				destroyEntity(entity);
+			}
 		}
+		m_markForDeletion.clear();
 	}
 
-	void Scene::destroyObject(const std::string &name) {
-
-		if (!m_nameIndexHash.contains(name)) {
-			Logger::warn("Attempted to destroy object with invalid name: " + name);
+	void Scene::destroyObject(SceneHandle handle) {
+		if (!isAlive(handle)) {
+			Logger::warn("Attempted to destroy object with stale handle: " + std::to_string(handle.index));
 			return;
 		}
-		// Get the object's index in the vector from the name hash
-		const auto index = m_nameIndexHash[name];
-
-		if (index >= m_sceneObjectsVec.size() && !m_sceneObjectsVec[index]) return;
-
-		// Get the object's ID before resetting
-		const auto id = m_sceneObjectsVec[index]->getID();
-
-		// Delete the object from the vector (free the slot)
-		m_sceneObjectsVec[index].reset();
-
-		// Recycle the freed index for reuse
-		m_freeIndicesStack.push(index);
-
-		// Recycle the freed ID for reuse
-		m_freeIDs.push(id);
+		destroyEntity(handle.toEntity());
+	}
 
-		// Remove from the ID-based map
-		if (m_sceneObjectsMap.contains(id)) {
-			m_sceneObjectsMap.erase(id);
-		} else {
-			Logger::warn("No object found for this ID: " + std::to_string(id));
+	void Scene::destroyObject(core::NameId name) {
+		const auto it = m_nameIndex.find(name);
+		if (it == m_nameIndex.end()) {
+			Logger::warn("Attempted to destroy object with invalid name: " + name.str());
 			return;
 		}
+		destroyEntity(it->second);
+	}
 
-		// Remove from the name -> index map
-		m_nameIndexHash.erase(name);
+	void Scene::destroyEntity(Entity entity) {
+		if (const auto name = m_world.getComponent<NameComponent>(entity); name && name->name.isValid()) {
+			m_nameIndex.erase(name->name);
+		}
+		if (const auto transform = m_world.getComponent<TransformComponent>(entity)) {
+			m_transformPool->destroy(transform->id);
+		}
+		if (const auto spatial = m_world.getComponent<SpatialProxyComponent>(entity); spatial && spatial->proxy != SpatialProxyComponent::NULL_PROXY) {
+			if (spatial->mobility == Mobility::Dynamic) m_grid.destroyProxy(spatial->proxy);
+			else m_bvh.destroyProxy(spatial->proxy);
+		}
+		// the entity's components go back to their pools, the slot and index are recycled by the World
+		m_world.deleteEntity(entity);
+		--m_objectCount;
+	}
+
+	bool Scene::isAlive(SceneHandle handle) const {
+		return m_world.isAlive(handle.toEntity());
+	}
+
+	SceneObject Scene::getObject(SceneHandle handle) {
+		if (!isAlive(handle)) return {};
+		return { this, handle };
 	}
 
-	const std::shared_ptr<SceneObject> & Scene::getObjectWithNameFromMap(const std::string &name) const {
-		if (m_sceneObjectsMap.contains(m_nameIndexHash.at(name))) {
-			return m_sceneObjectsMap.at(m_nameIndexHash.at(name));
+	SceneObject Scene::getObjectWithNameFromMap(core::NameId name) {
+		if (const auto it = m_nameIndex.find(name); it != m_nameIndex.end()) {
+			return { this, it->second };
 		}
 		return {};
 	}
 
+	SceneObject Scene::getObjectWithNameFromMap(const std::string &name) {
+		// a string that was never interned can't be the name of an object
+		const core::NameId id = core::NameId::find(name);
+		return id.isValid() ? getObjectWithNameFromMap(id) : SceneObject{};
+	}
+
 	void Scene::updateInputComponents()
 	{
-		if (m_inputComponents.empty()) {
-			return;
-		}
-
-		for (const auto& component : m_inputComponents) {
-			if (!component) {
-				Logger::warn("[SceneObject] Input Component is nullptr, skipping update!");
+		// copied out first, processInput may add or remove input handlers
+		m_inputQueue.clear();
+		m_world.view<InputHandlerComponent>().each([&](InputHandlerComponent& handler) {
+			if (!handler.input) {
+				Logger::warn("[Scene::updateInputComponents] Input Component is nullptr, skipping update!");
 				return;
 			}
+			m_inputQueue.push_back(handler.input);
+		});
+
+		for (const auto& component : m_inputQueue) {
 			component->processInput(*this);
 		}
 	}
 
-}
\ No newline at end of file
+	void Scene::updateSpatialIndex()
+	{
+		const Graphics::TransformPool& pool = *m_transformPool;
+
+		m_world.view<TransformComponent, MeshComponent, SpatialProxyComponent>().each(
+			[&](Entity entity, TransformComponent& transform, MeshComponent& mesh, SpatialProxyComponent& spatial) {
+				// world matrix not computed yet (created after this frame's updateMatrices)
+				if (pool.isDirty(transform.id)) return;
+
+				const bool inserted = spatial.proxy != SpatialProxyComponent::NULL_PROXY;
+				if (inserted && !pool.hasWorldChanged(transform.id)) return;
+
+				if (!mesh.subMesh && mesh.meshData) {
+					mesh.subMesh = mesh.meshData->findObjectInfo(mesh.subMeshName);
+				}
+				if (!mesh.subMesh) return;
+
+				const MATH::AABB worldBounds = MATH::transformAABB(mesh.subMesh->localBounds, pool.getWorldMatrix(transform.id));
+				if (spatial.mobility == Mobility::Dynamic) {
+					if (inserted) m_grid.moveProxy(spatial.proxy, worldBounds);
+					else spatial.proxy = m_grid.createProxy(worldBounds, entity);
+				} else {
+					if (inserted) m_bvh.moveProxy(spatial.proxy, worldBounds);
+					else spatial.proxy = m_bvh.createProxy(worldBounds, entity);
+				}
+			});
+	}
+
+	void Scene::setMobility(SceneHandle handle, Mobility mobility)
+	{
+		if (!isAlive(handle)) return;
+
+		const auto spatial = m_world.getComponent<SpatialProxyComponent>(handle.toEntity());
+		if (!spatial || spatial->mobility == mobility) return;
+
+		if (spatial->proxy != SpatialProxyComponent::NULL_PROXY) {
+			// the bounds move over as they are, the next updateSpatialIndex keeps them current
+			if (spatial->mobility == Mobility::Dynamic) {
+				const MATH::AABB bounds = m_grid.getAABB(spatial->proxy);
+				m_grid.destroyProxy(spatial->proxy);
+				spatial->proxy = m_bvh.createProxy(bounds, handle.toEntity());
+			} else {
+				const MATH::AABB bounds = m_bvh.getAABB(spatial->proxy);
+				m_bvh.destroyProxy(spatial->proxy);
+				spatial->proxy = m_grid.createProxy(bounds, handle.toEntity());
+			}
+		}
+		spatial->mobility = mobility;
+	}
+
+	SceneHandle Scene::pick(const glm::vec3& origin, const glm::vec3& direction, float maxDistance) const
+	{
+		// the grid's ray is clipped to the BVH's hit, it only reports something closer
+		const SPATIAL::QueryHit staticHit = m_bvh.raycastClosest(origin, direction, maxDistance);
+		const SPATIAL::QueryHit dynamicHit = m_grid.raycastClosest(origin, direction, staticHit.hit ? staticHit.distance : maxDistance);
+		const SPATIAL::QueryHit& hit = dynamicHit.hit ? dynamicHit : staticHit;
+		return hit.hit ? SceneHandle::fromEntity(hit.userData) : SceneHandle{};
+	}
+
+	SceneHandle Scene::findNearest(const glm::vec3& point, float maxDistance) const
+	{
+		const SPATIAL::QueryHit staticHit = m_bvh.nearest(point, maxDistance);
+		const SPATIAL::QueryHit dynamicHit = m_grid.nearest(point, maxDistance);
+		// distances are squared in both
+		const SPATIAL::QueryHit& hit = dynamicHit.hit && (!staticHit.hit || dynamicHit.distance < staticHit.distance) ? dynamicHit : staticHit;
+		return hit.hit ? SceneHandle::fromEntity(hit.userData) : SceneHandle{};
+	}
+
+}
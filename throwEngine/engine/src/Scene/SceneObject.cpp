@@ -1,98 +1,63 @@
 #include "Scene/SceneObject.h"
 
-#include "graphics/Renderer/RenderData.h"
+#include "Scene/Scene.h"
+#include "Scene/SceneComponents.h"
 
-#include "graphics/Transformations/Transformations.h"
+#include "graphics/Transformations/TransformComponent.h"
+#include "graphics/Transformations/TransformPool.h"
 
-#include "graphics/Shaders/ShaderProgram.h"
-#include "graphics/Shaders/BasicShader.h"
-
-#include <graphics/Textures/Textures.h>
+#include "graphics/Shaders/ShaderInterface.h"
 
+#include "graphics/Material/MaterialComponent.h"
 #include "graphics/Material/MaterialLib.h"
 
-#include "graphics/Lighting/LightManager.h"
-
-#include "graphics/Camera/Camera.h"
-
 #include <core/Logger.h>
-#include "core/Debug.h"
-#include "core/Engine.h"
-#include "core/Engine.h"
-#define DEBUG_PTR(ptr) DEBUG::DebugForEngineObjectPointers(ptr)
 
 namespace SCENE {
-    SceneObject::SceneObject(std::shared_ptr<Graphics::IMesh> mesh, std::string materialName)
-        : m_mesh(mesh), m_transform(std::make_shared<Graphics::Transform>()), m_materialName(materialName) {
-        DEBUG_PTR(m_transform);
-        DEBUG_PTR(m_mesh);
+    namespace {
+        const glm::mat4 IDENTITY(1.0f);
     }
 
-    bool SceneObject::validateRenderState(const std::shared_ptr<Graphics::RenderData> &renderData) {
-        // shader is an interface
-        const auto &iShader = m_shaderInterface;
-        DEBUG_PTR(iShader);
-
-        if (!iShader) {
-            Logger::warn("[SceneObject] Shader Interface not found! Skipping draw.");
-            return false;
-        }
-
-        if (!iShader->getGLShaderProgram()) {
-            Logger::warn("[SceneObject::validateRenderState] getGLShaderProgram is nullptr!");
-            return false;
-        }
-
-        const auto lightManager = renderData->getLightManager();
-        DEBUG_PTR(lightManager);
-
-        if (!lightManager) {
-            Logger::warn("[SceneObject] LightManager missing! Skipping draw.");
-            return false;
-        }
-
-        auto &material = m_materialInstance;
-        DEBUG_PTR(material);
-
-        if (!material) {
-            Logger::info("[SceneObject] Material missing! Not skipping but assign default material!");
-            material = renderData->getMaterialLib()->getDefaultMaterial();
-            return false;
-        }
-
-        const auto textureManager = renderData->getTextureManager();
-        DEBUG_PTR(textureManager);
-
-        if (!textureManager) {
-            Logger::warn("[SceneObject] TextureManager missing! Skipping draw.");
-            return false;
-        }
-
-        const auto camera = renderData->getCamera();
-        DEBUG_PTR(camera);
+    bool SceneObject::isValid() const {
+        return m_scene && m_scene->getWorld().isAlive(m_entity);
+    }
 
-        if (!camera) {
-            Logger::warn("[SceneObject] Camera missing! Skipping draw.");
-            return false;
-        }
+    core::NameId SceneObject::getNameId() const {
+        if (!isValid()) return {};
+        const auto name = m_scene->getWorld().getComponent<NameComponent>(m_entity);
+        return name ? name->name : core::NameId{};
+    }
 
-        return true;
+    std::shared_ptr<Graphics::Material> SceneObject::getMaterialInstance() const {
+        if (!isValid()) return {};
+        const auto material = m_scene->getWorld().getComponent<MaterialComponent>(m_entity);
+        return material ? material->material : nullptr;
     }
 
-    void SceneObject::initializeMaterial(const std::shared_ptr<Graphics::MaterialLibrary> &library) {
-        // take a copy of material
-        const auto base = library->getMaterialByName(m_materialName);
-        // then create a material instance for a scene object
-        m_materialInstance = std::make_shared<Graphics::Material>(*base);
+    std::shared_ptr<Graphics::Material> SceneObject::getEditableMaterial() {
+        if (!isValid()) return {};
+        const auto material = m_scene->getWorld().getComponent<MaterialComponent>(m_entity);
+        if (!material || !material->material) {
+            Logger::warn("[SceneObject::getEditableMaterial] " + getName() + " has no material!");
+            return {};
+        }
 
-        if (!m_materialInstance) {
-            Logger::warn("[SceneObject::initializeMaterial] m_materialInstance is doesn't exist!");
+        // we are copying the material so we can change it without affecting the library material
+        // (and every other object sharing it)
+        if (!material->ownsMaterial) {
+            material->material = std::make_shared<Graphics::Material>(*material->material);
+            material->ownsMaterial = true;
         }
+        return material->material;
     }
 
     void SceneObject::setMaterialInstance(std::shared_ptr<Graphics::Material> instance) {
-        // we are copying materials because we can change to without affect original material
-        m_materialInstance = instance;
+        if (!isValid()) return;
+        if (const auto material = m_scene->getWorld().getComponent<MaterialComponent>(m_entity)) {
+            material->material = std::move(instance);
+            // whoever hands one in decides whether it is shared, a later edit copies it again
+            material->ownsMaterial = false;
+        }
     }
 
     void SceneObject::setShaderInterface(std::shared_ptr<SHADER::IShader> shader) {
@@ -100,70 +65,94 @@ namespace SCENE {
             Logger::error("[ERROR] [SceneObject::setShaderInterface] Shader is nullptr!");
             return;
         }
+        if (!isValid()) return;
+
         switch (shader->getType()) {
             case SHADER::ShaderType::BASIC:
-                m_shaderInterface = shader;
+                if (const auto material = m_scene->getWorld().getComponent<MaterialComponent>(m_entity)) {
+                    material->shader = std::move(shader);
+                }
                 return;
             default:
                 Logger::error("[ERROR] [SceneObject::setShaderInterface] Unknown Shader type!");
         }
     }
 
-    void SceneObject::draw(const glm::mat4 &view, const glm::mat4 &projection,
-                           const std::shared_ptr<Graphics::RenderData> &renderData) {
-        // check nullptr and other debugging stuff
-        if (!validateRenderState(renderData)) {
-            Logger::warn("[ERROR] [SceneObject::draw]: " + m_objectName + " check up!!!");
-            Logger::error("[ERROR] [SceneObject::draw] validateRenderState pointer initialization failed!");
-            return;
+    std::shared_ptr<SHADER::IShader> SceneObject::getShaderInterface() const {
+        if (!isValid()) return {};
+        const auto material = m_scene->getWorld().getComponent<MaterialComponent>(m_entity);
+        return material ? material->shader : nullptr;
+    }
+
+    void SceneObject::setInputComponent(const std::shared_ptr<Input::IInputComponent> &inputComponent) {
+        if (!isValid()) return;
+        auto &world = m_scene->getWorld();
+        if (const auto handler = world.getComponent<InputHandlerComponent>(m_entity)) {
+            if (inputComponent) handler->input = inputComponent;
+            else world.removeComponent<InputHandlerComponent>(m_entity);
+        } else if (inputComponent) {
+            world.addComponent(m_entity, InputHandlerComponent{ inputComponent });
         }
+    }
 
-        const auto model = m_transform->getModelMatrix();
-        const glm::vec3 cameraPos = renderData->getCamera()->getCameraPosition();
+    std::shared_ptr<Input::IInputComponent> SceneObject::getInputComponent() const {
+        if (!isValid()) return {};
+        const auto handler = m_scene->getWorld().getComponent<InputHandlerComponent>(m_entity);
+        return handler ? handler->input : nullptr;
+    }
 
-        // prepare shader and set uniforms
-        prepareShader(model, view, projection, cameraPos, renderData);
+    uint32_t SceneObject::getTransformID() const {
+        if (!isValid()) return Graphics::TransformPool::INVALID_ID;
+        const auto transform = m_scene->getWorld().getComponent<TransformComponent>(m_entity);
+        return transform ? transform->id : Graphics::TransformPool::INVALID_ID;
+    }
 
-        // draw per object
-        m_mesh->drawMeshObject();
+    glm::vec3 SceneObject::getPosition() const {
+        const uint32_t id = getTransformID();
+        return id != Graphics::TransformPool::INVALID_ID ? m_scene->getTransformPool()->getPosition(id) : glm::vec3(0.0f);
     }
 
-    void SceneObject::prepareShader(const glm::mat4 &model, const glm::mat4 &view, const glm::mat4 &projection,
-                                    const glm::vec3 &cameraPos,
-                                    const std::shared_ptr<Graphics::RenderData> &renderData) const {
-        if (!m_shaderInterface) {
-            Logger::warn("[ERROR] [SceneObject::prepareShader] Shader Interface not found! skipping..");
-            return;
-        }
-        const auto &iShader = m_shaderInterface;
-        iShader->setRenderDataObject(renderData);
-        iShader->bind();
+    glm::vec3 SceneObject::getEulerAngles() const {
+        const uint32_t id = getTransformID();
+        return id != Graphics::TransformPool::INVALID_ID ? m_scene->getTransformPool()->getEulerAngles(id) : glm::vec3(0.0f);
+    }
 
-        const auto &material = m_materialInstance;
-        const auto texture = renderData->getTextureManager();
+    glm::vec3 SceneObject::getScale() const {
+        const uint32_t id = getTransformID();
+        return id != Graphics::TransformPool::INVALID_ID ? m_scene->getTransformPool()->getScale(id) : glm::vec3(1.0f);
+    }
 
-        // bind material
-        bindMaterialAndTextures(renderData);
+    void SceneObject::setPosition(const glm::vec3 &position) {
+        const uint32_t id = getTransformID();
+        if (id != Graphics::TransformPool::INVALID_ID) m_scene->getTransformPool()->setPosition(id, position);
+    }
 
-        // Upload lights and set global ambient
-        iShader->getGLShaderProgram()->setVec3("globalAmbient", renderData->getGlobalAmbient());
+    void SceneObject::setRotation(const glm::vec3 &eulerAngles) {
+        const uint32_t id = getTransformID();
+        if (id != Graphics::TransformPool::INVALID_ID) m_scene->getTransformPool()->setRotation(id, eulerAngles);
+    }
 
-        renderData->getLightManager()->uploadLights(iShader->getGLShaderProgram());
+    void SceneObject::setScale(const glm::vec3 &scale) {
+        const uint32_t id = getTransformID();
+        if (id != Graphics::TransformPool::INVALID_ID) m_scene->getTransformPool()->setScale(id, scale);
+    }
 
-        // Bind material and textures
-        iShader->setMaterial(material);
+    const glm::mat4 &SceneObject::getModelMatrix() const {
+        const uint32_t id = getTransformID();
+        return id != Graphics::TransformPool::INVALID_ID ? m_scene->getTransformPool()->getWorldMatrix(id) : IDENTITY;
+    }
 
-        // Set matrices and camera position
-        iShader->setMatrices(model, view, projection, cameraPos);
+    Mobility SceneObject::getMobility() const {
+        if (!isValid()) return Mobility::Static;
+        const auto spatial = m_scene->getWorld().getComponent<SpatialProxyComponent>(m_entity);
+        return spatial ? spatial->mobility : Mobility::Static;
     }
 
-    void SceneObject::bindMaterialAndTextures(const std::shared_ptr<Graphics::RenderData> &renderData) const {
-        const auto texture = renderData->getTextureManager();
-        const auto &material = m_materialInstance;
+    void SceneObject::setMobility(Mobility mobility) {
+        if (isValid()) m_scene->setMobility(getHandle(), mobility);
+    }
 
-        if (material->m_diffuseTexture)
-            texture->bind(material->m_diffuseTexture->glID, 0);
-        if (material->m_specularTexture)
-            texture->bind(material->m_specularTexture->glID, 1);
+    void SceneObject::markForDeletion() {
+        if (isValid()) m_scene->markToBeDeleted(getHandle());
     }
 }
@@ -11,13 +11,10 @@
 #include "graphics/Renderer/RenderData.h"
 #include <Input/InputComponent.h>
 #include <Input/InputComponentFactory.h>
-#include "graphics/Transformations/Transformations.h"
 #include <core/Logger.h>
 #include "graphics/Lighting/LightManager.h"
 #include "graphics/Shaders/BasicShader.h"
 
-constexpr auto BASIC_SHADER = "basic";
-
 namespace SCENE
 {
     struct SceneObjectFactory::Impl
@@ -70,141 +67,123 @@ namespace SCENE
         addMesh("circle");
     }
 
-    std::shared_ptr<SceneObject> SceneObjectFactory::createCube(const glm::vec3& pos, const std::string& materialName, bool visualLightObj) const
+    SceneObject SceneObjectFactory::createCube(const glm::vec3& pos, const std::string& materialName) const
     {
-        // Create cube as a scene object
-        auto cube = std::make_shared<SceneObject>(
-            std::make_shared<Graphics::MeshCube3D>(m_pImpl->meshData,
-                m_pImpl->meshData->getObjectInfo("cube")), materialName
-        );
-        cube->getTransform()->setPosition(pos);
-
-        if (!cube) {
-            Logger::warn("[SceneObjectFactory::createCube] cube is nullptr");
-            return {};
-        }
+        return createShape("cube", generateName("cube"), pos, glm::vec3{ 7.5f, 7.5f, 7.5f }, materialName);
+    }
 
-        cube->setShaderInterface(m_renderData->getShaderInterface(BASIC_SHADER));
-        cube->setName(generateName("cube"));
-        cube->initializeMaterial(m_renderData->getMaterialLib());
-        cube->getTransform()->setPosition(glm::vec3(0.0));
-        cube->getTransform()->setScale(glm::vec3{ 7.5f, 7.5f, 7.5f });
+    SceneObject SceneObjectFactory::createSphere(const glm::vec3& pos, const std::string& materialName) const
+    {
+        return createShape("sphere", generateName("sphere"), pos, glm::vec3{ 3.5f, 3.5f, 3.5f }, materialName);
+    }
 
-        if (!visualLightObj)
-            m_scene->createObjectProperties(cube);
+    std::vector<SceneHandle> SceneObjectFactory::createCubes(std::span<const glm::vec3> positions, const std::string& materialName) const
+    {
+        return createShapes("cube", positions, glm::vec3{ 7.5f, 7.5f, 7.5f }, materialName);
+    }
 
-        return cube;
+    std::vector<SceneHandle> SceneObjectFactory::createSpheres(std::span<const glm::vec3> positions, const std::string& materialName) const
+    {
+        return createShapes("sphere", positions, glm::vec3{ 3.5f, 3.5f, 3.5f }, materialName);
     }
 
-    std::shared_ptr<SceneObject> SceneObjectFactory::createSphere(const glm::vec3& pos, const std::string& materialName, bool visualLightObj) const
+    SceneObject SceneObjectFactory::createShape(const std::string& subMeshName, core::NameId name,
+        const glm::vec3& pos, const glm::vec3& scale, const std::string& materialName, Mobility mobility) const
     {
-		// Create a sphere object with the specified material and position
-        auto sphere = std::make_shared<SceneObject>(
-            std::make_shared<Graphics::MeshSphere3D>(m_pImpl->meshData,
-                m_pImpl->meshData->getObjectInfo("sphere")), materialName
-        );
-        sphere->getTransform()->setPosition(pos);
-
-        if (!sphere) {
-            Logger::warn("[SceneObjectFactory::createSphere] sphere is nullptr");
+        if (!m_scene) {
+            Logger::warn("[SceneObjectFactory::createShape] scene is nullptr, can't create " + name.str());
             return {};
         }
 
-        sphere->setShaderInterface(m_renderData->getShaderInterface(BASIC_SHADER));
-        sphere->setName(generateName("sphere"));
-        sphere->initializeMaterial(m_renderData->getMaterialLib());
-        sphere->getTransform()->setPosition(glm::vec3(0.0));
-        sphere->getTransform()->setScale(glm::vec3{ 3.5f, 3.5f, 3.5f });
-
-        if (!visualLightObj)
-            m_scene->createObjectProperties(sphere);
+        SceneObjectDesc desc{
+            .name = name,
+            .subMeshName = subMeshName,
+            .material = getMaterialOrDefault(materialName),
+            .shader = m_renderData->getShaderInterface(SHADER::DEFAULT_INSTANCED_SHADER),
+            .position = pos,
+            .scale = scale,
+            .mobility = mobility,
+        };
 
-        return sphere;
+        return m_scene->getObject(m_scene->createObjectProperties(desc));
     }
 
-    bool SceneObjectFactory::createPointLight(const std::string& materialName,
-        const glm::vec3& position) const
+    std::vector<SceneHandle> SceneObjectFactory::createShapes(const std::string& subMeshName, std::span<const glm::vec3> positions,
+        const glm::vec3& scale, const std::string& materialName) const
     {
-		// Create visual representation (sphere)
-        const auto lightVisualObject = createSphere(position, materialName, true);
-
-        if (!lightVisualObject) {
-            Logger::error("[SceneObjectFactory::createPointLight] Failed to create lightVisualObject.");
-            return false;
-		}
-
-        lightVisualObject->setShaderInterface(m_renderData->getShaderInterface(BASIC_SHADER));
-        lightVisualObject->setName(generateName("point"));
-
-        auto lightData = std::make_shared<LIGHTING::LightData>(position);
-
-        auto light = std::make_shared<LIGHTING::Light>(lightData);
-        light->setType(LIGHTING::LightType::Point);
+        if (!m_scene) {
+            Logger::warn("[SceneObjectFactory::createShapes] scene is nullptr, can't create " + std::to_string(positions.size()) + " objects");
+            return {};
+        }
 
-        m_scene->createObjectProperties(lightVisualObject);
+        // no names: nothing to generate, and the scene's name index stays out of it
+        const SceneObjectDesc prototype{
+            .subMeshName = subMeshName,
+            .material = getMaterialOrDefault(materialName),
+            .shader = m_renderData->getShaderInterface(SHADER::DEFAULT_INSTANCED_SHADER),
+            .scale = scale,
+        };
 
-        m_renderData->getLightManager()->addLight(light);
+        return m_scene->createObjects(prototype, positions);
+    }
 
-        return true;
+    std::shared_ptr<Graphics::Material> SceneObjectFactory::getMaterialOrDefault(const std::string& materialName) const
+    {
+        // objects share the library material, SceneObject::getEditableMaterial copies it on the first edit
+        auto material = m_renderData->getMaterialLib()->getMaterialByName(materialName);
+        if (!material) {
+            Logger::warn("[SceneObjectFactory] no material named " + materialName + ", using default material!");
+            material = m_renderData->getMaterialLib()->getDefaultMaterial();
+        }
+        return material;
     }
 
-    bool SceneObjectFactory::createDirectionalLight(const std::string& materialName,
-        const glm::vec3& position) const
+    bool SceneObjectFactory::createLight(LIGHTING::LightType type, const std::string& typeName,
+        const std::string& materialName, const glm::vec3& position) const
     {
-        // Create visual representation (sphere)
-        const auto lightVisualObject = createSphere(position, materialName, true);
+        // Create visual representation (sphere), lights are moved by their input component every frame
+        const auto lightVisualObject = createShape("sphere", generateName(typeName), position,
+            glm::vec3{ 3.5f, 3.5f, 3.5f }, materialName, Mobility::Dynamic);
 
         if (!lightVisualObject) {
-            Logger::error("[SceneObjectFactory::createDirectionalLight] Failed to create lightVisualObject.");
+            Logger::error("[SceneObjectFactory::createLight] Failed to create lightVisualObject.");
             return false;
-		}
-
-        lightVisualObject->setShaderInterface(m_renderData->getShaderInterface(BASIC_SHADER));
-        lightVisualObject->setName(generateName("directional"));
+        }
 
         auto lightData = std::make_shared<LIGHTING::LightData>(position);
 
-        auto light = std::make_shared<LIGHTING::Light>(lightData);
-        light->setType(LIGHTING::LightType::Directional);
-
-        m_scene->createObjectProperties(lightVisualObject);
+        const auto light = std::make_shared<LIGHTING::Light>(lightData);
+        light->setType(type);
+        light->setVisual(lightVisualObject);
 
         m_renderData->getLightManager()->addLight(light);
 
         return true;
     }
 
-    bool SceneObjectFactory::createSpotLight(const std::string& materialName,
+    bool SceneObjectFactory::createPointLight(const std::string& materialName,
         const glm::vec3& position) const
     {
-		// Create visual representation (sphere)
-        const auto lightVisualObject = createSphere(position, materialName, true);
-
-        if (!lightVisualObject) {
-            Logger::error("[SceneObjectFactory::createSpotLight] Failed to create lightVisualObject.");
-            return false;
-        }
-
-        lightVisualObject->setShaderInterface(m_renderData->getShaderInterface(BASIC_SHADER));
-        lightVisualObject->setName(generateName("spot"));
-
-        auto lightData = std::make_shared<LIGHTING::LightData>(position);
-
-        const auto light = std::make_shared<LIGHTING::Light>(lightData);
-        light->setType(LIGHTING::LightType::Spot);
-
-        m_scene->createObjectProperties(lightVisualObject);
+        return createLight(LIGHTING::LightType::Point, "point", materialName, position);
+    }
 
-        m_renderData->getLightManager()->addLight(light);
+    bool SceneObjectFactory::createDirectionalLight(const std::string& materialName,
+        const glm::vec3& position) const
+    {
+        return createLight(LIGHTING::LightType::Directional, "directional", materialName, position);
+    }
 
-		return true;
+    bool SceneObjectFactory::createSpotLight(const std::string& materialName,
+        const glm::vec3& position) const
+    {
+        return createLight(LIGHTING::LightType::Spot, "spot", materialName, position);
     }
 
-    std::string SceneObjectFactory::generateName(const std::string &type)
+    core::NameId SceneObjectFactory::generateName(const std::string &type)
     {
-        static std::unordered_map<std::string, uint32_t> typeCounters;
-        uint32_t& counter = typeCounters[type];
+        static std::unordered_map<core::NameId, uint32_t> typeCounters;
+        uint32_t& counter = typeCounters[core::NameId(type)];
         ++counter;
-        return type + "_" + std::to_string(counter);
+        return core::NameId(type + "_" + std::to_string(counter));
     }
 }
@@ -0,0 +1,303 @@
+#include "Spatial/DynamicBVH.h"
+
+#include <algorithm>
+
+namespace SPATIAL {
+
+    uint32_t DynamicBVH::createProxy(const MATH::AABB &box, uint32_t userData) {
+        const uint32_t proxy = allocateNode();
+        Node& node = m_nodes[proxy];
+        node.tight = box;
+        node.box = box.fattened(m_margin);
+        node.userData = userData;
+        node.height = 0;
+
+        insertLeaf(proxy);
+        ++m_proxyCount;
+        return proxy;
+    }
+
+    void DynamicBVH::destroyProxy(uint32_t proxy) {
+        removeLeaf(proxy);
+        freeNode(proxy);
+        --m_proxyCount;
+    }
+
+    bool DynamicBVH::moveProxy(uint32_t proxy, const MATH::AABB &box) {
+        Node& node = m_nodes[proxy];
+        node.tight = box;
+        if (node.box.contains(box)) return false;
+
+        removeLeaf(proxy);
+        m_nodes[proxy].box = box.fattened(m_margin);
+        insertLeaf(proxy);
+        return true;
+    }
+
+    float DynamicBVH::computeCost() const {
+        if (m_root == NULL_NODE) return 0.0f;
+
+        float internalArea = 0.0f;
+        NodeStack stack;
+        stack.push(m_root);
+        while (!stack.empty()) {
+            const Node& node = m_nodes[stack.pop()];
+            if (node.isLeaf()) continue;
+
+            internalArea += node.box.getSurfaceArea();
+            stack.push(node.child1);
+            stack.push(node.child2);
+        }
+
+        const float rootArea = m_nodes[m_root].box.getSurfaceArea();
+        return rootArea > 0.0f ? internalArea / rootArea : 0.0f;
+    }
+
+    void DynamicBVH::clear() {
+        m_nodes.clear();
+        m_root = NULL_NODE;
+        m_freeList = NULL_NODE;
+        m_proxyCount = 0;
+    }
+
+    QueryHit DynamicBVH::raycastClosest(const glm::vec3 &origin, const glm::vec3 &direction, float maxT) const {
+        QueryHit result;
+        raycast(origin, direction, maxT, [&result](uint32_t userData, float tEnter) {
+            result = { userData, tEnter, true };
+            // only something closer than this hit is still interesting
+            return tEnter;
+        });
+        return result;
+    }
+
+    QueryHit DynamicBVH::nearest(const glm::vec3 &point, float maxDistance) const {
+        QueryHit result;
+        if (m_root == NULL_NODE) return result;
+
+        float bestDistance = maxDistance < std::numeric_limits<float>::max() ? maxDistance * maxDistance : maxDistance;
+
+        NodeStack stack;
+        stack.push(m_root);
+        while (!stack.empty()) {
+            const Node& node = m_nodes[stack.pop()];
+            if (node.box.distanceSquared(point) > bestDistance) continue;
+
+            if (node.isLeaf()) {
+                const float distance = node.tight.distanceSquared(point);
+                if (distance <= bestDistance) {
+                    bestDistance = distance;
+                    result = { node.userData, distance, true };
+                }
+                continue;
+            }
+
+            // nearer child on top, it usually tightens bestDistance enough to skip the other one
+            const float d1 = m_nodes[node.child1].box.distanceSquared(point);
+            const float d2 = m_nodes[node.child2].box.distanceSquared(point);
+            stack.push(d1 < d2 ? node.child2 : node.child1);
+            stack.push(d1 < d2 ? node.child1 : node.child2);
+        }
+        return result;
+    }
+
+    uint32_t DynamicBVH::allocateNode() {
+        if (m_freeList == NULL_NODE) {
+            m_nodes.emplace_back();
+            return static_cast<uint32_t>(m_nodes.size() - 1);
+        }
+
+        const uint32_t node = m_freeList;
+        m_freeList = m_nodes[node].parent;
+        m_nodes[node] = Node{};
+        return node;
+    }
+
+    void DynamicBVH::freeNode(uint32_t node) {
+        m_nodes[node].parent = m_freeList;
+        m_nodes[node].child1 = NULL_NODE;
+        m_nodes[node].child2 = NULL_NODE;
+        m_freeList = node;
+    }
+
+    uint32_t DynamicBVH::findBestSibling(const MATH::AABB &box) const {
+        // SAH descent (as in Box2D v3): the cost of making a node the sibling is the area of the new parent
+        // plus how much every ancestor grows ("inherited" cost). At each step the child with the lower
+        // bound is followed, and the walk stops once neither child can beat the best sibling found so far.
+        const float leafArea = box.getSurfaceArea();
+
+        uint32_t node = m_root;
+        float nodeArea = m_nodes[node].box.getSurfaceArea();
+        float directCost = MATH::merge(m_nodes[node].box, box).getSurfaceArea();
+        float inheritedCost = 0.0f;
+
+        uint32_t best = node;
+        float bestCost = directCost;
+
+        while (!m_nodes[node].isLeaf()) {
+            const Node& current = m_nodes[node];
+
+            const float cost = directCost + inheritedCost;
+            if (cost < bestCost) {
+                bestCost = cost;
+                best = node;
+            }
+
+            // pairing with anything below this node grows it by this much
+            inheritedCost += directCost - nodeArea;
+
+            const auto evaluate = [&](uint32_t child, float& childDirectCost, float& childArea) {
+                const Node& childNode = m_nodes[child];
+                childDirectCost = MATH::merge(childNode.box, box).getSurfaceArea();
+                if (childNode.isLeaf()) {
+                    const float childCost = childDirectCost + inheritedCost;
+                    if (childCost < bestCost) {
+                        bestCost = childCost;
+                        best = child;
+                    }
+                    return std::numeric_limits<float>::max();
+                }
+                childArea = childNode.box.getSurfaceArea();
+                // a descendant's new parent is at least as large as the leaf, the child grows at least this much
+                return inheritedCost + childDirectCost + std::min(leafArea - childArea, 0.0f);
+            };
+
+            float directCost1, area1 = 0.0f, directCost2, area2 = 0.0f;
+            const float lowerCost1 = evaluate(current.child1, directCost1, area1);
+            const float lowerCost2 = evaluate(current.child2, directCost2, area2);
+
+            if (bestCost <= lowerCost1 && bestCost <= lowerCost2) break;
+
+            if (lowerCost1 <= lowerCost2) {
+                node = current.child1;
+                nodeArea = area1;
+                directCost = directCost1;
+            } else {
+                node = current.child2;
+                nodeArea = area2;
+                directCost = directCost2;
+            }
+        }
+        return best;
+    }
+
+    void DynamicBVH::insertLeaf(uint32_t leaf) {
+        if (m_root == NULL_NODE) {
+            m_root = leaf;
+            m_nodes[leaf].parent = NULL_NODE;
+            return;
+        }
+
+        const uint32_t sibling = findBestSibling(m_nodes[leaf].box);
+
+        // allocateNode may grow m_nodes, no references are held across it
+        const uint32_t newParent = allocateNode();
+        const uint32_t oldParent = m_nodes[sibling].parent;
+
+        Node& parent = m_nodes[newParent];
+        parent.parent = oldParent;
+        parent.box = MATH::merge(m_nodes[leaf].box, m_nodes[sibling].box);
+        parent.height = m_nodes[sibling].height + 1;
+        parent.child1 = sibling;
+        parent.child2 = leaf;
+
+        if (oldParent == NULL_NODE) {
+            m_root = newParent;
+        } else if (m_nodes[oldParent].child1 == sibling) {
+            m_nodes[oldParent].child1 = newParent;
+        } else {
+            m_nodes[oldParent].child2 = newParent;
+        }
+        m_nodes[sibling].parent = newParent;
+        m_nodes[leaf].parent = newParent;
+
+        refitAncestors(newParent, true);
+    }
+
+    void DynamicBVH::removeLeaf(uint32_t leaf) {
+        if (leaf == m_root) {
+            m_root = NULL_NODE;
+            return;
+        }
+
+        const uint32_t parent = m_nodes[leaf].parent;
+        const uint32_t grandParent = m_nodes[parent].parent;
+        const uint32_t sibling = m_nodes[parent].child1 == leaf ? m_nodes[parent].child2 : m_nodes[parent].child1;
+
+        // the sibling takes the parent's place
+        if (grandParent == NULL_NODE) {
+            m_root = sibling;
+        } else if (m_nodes[grandParent].child1 == parent) {
+            m_nodes[grandParent].child1 = sibling;
+        } else {
+            m_nodes[grandParent].child2 = sibling;
+        }
+        m_nodes[sibling].parent = grandParent;
+        freeNode(parent);
+        m_nodes[leaf].parent = NULL_NODE;
+
+        refitAncestors(grandParent, true);
+    }
+
+    void DynamicBVH::refitAncestors(uint32_t node, bool rotateNodes) {
+        while (node != NULL_NODE) {
+            Node& current = m_nodes[node];
+            const Node& child1 = m_nodes[current.child1];
+            const Node& child2 = m_nodes[current.child2];
+            current.box = MATH::merge(child1.box, child2.box);
+            current.height = 1 + std::max(child1.height, child2.height);
+
+            if (rotateNodes) rotate(node);
+            node = m_nodes[node].parent;
+        }
+    }
+
+    void DynamicBVH::rotate(uint32_t a) {
+        // Kopta et al. tree rotations: swap a child of a with a grandchild under the other child when
+        // that shrinks the one node whose box changes. a's own box stays the same.
+        const Node& nodeA = m_nodes[a];
+        if (nodeA.height < 2) return;
+
+        const uint32_t b = nodeA.child1;
+        const uint32_t c = nodeA.child2;
+
+        struct Rotation {
+            uint32_t moveDown;  // child of a
+            uint32_t other;     // the other child of a, gets moveDown
+            uint32_t moveUp;    // child of other, goes to a
+            float gain = 0.0f;  // area removed from other
+        } best{ NULL_NODE, NULL_NODE, NULL_NODE };
+
+        const auto consider = [&](uint32_t moveDown, uint32_t other) {
+            const Node& otherNode = m_nodes[other];
+            if (otherNode.isLeaf()) return;
+
+            const float area = otherNode.box.getSurfaceArea();
+            const MATH::AABB& movedBox = m_nodes[moveDown].box;
+            // moving otherNode.child1 up leaves other with {moveDown, child2}, and the other way round
+            const float gain1 = area - MATH::merge(movedBox, m_nodes[otherNode.child2].box).getSurfaceArea();
+            const float gain2 = area - MATH::merge(movedBox, m_nodes[otherNode.child1].box).getSurfaceArea();
+            if (gain1 > best.gain) best = { moveDown, other, otherNode.child1, gain1 };
+            if (gain2 > best.gain) best = { moveDown, other, otherNode.child2, gain2 };
+        };
+        consider(b, c);
+        consider(c, b);
+
+        if (best.moveDown == NULL_NODE) return;
+
+        Node& nodeOther = m_nodes[best.other];
+        Node& nodeA2 = m_nodes[a];
+
+        if (nodeA2.child1 == best.moveDown) nodeA2.child1 = best.moveUp;
+        else nodeA2.child2 = best.moveUp;
+
+        if (nodeOther.child1 == best.moveUp) nodeOther.child1 = best.moveDown;
+        else nodeOther.child2 = best.moveDown;
+
+        m_nodes[best.moveUp].parent = a;
+        m_nodes[best.moveDown].parent = best.other;
+
+        nodeOther.box = MATH::merge(m_nodes[nodeOther.child1].box, m_nodes[nodeOther.child2].box);
+        nodeOther.height = 1 + std::max(m_nodes[nodeOther.child1].height, m_nodes[nodeOther.child2].height);
+        nodeA2.height = 1 + std::max(m_nodes[nodeA2.child1].height, m_nodes[nodeA2.child2].height);
+    }
+}
@@ -0,0 +1,230 @@
+#include "Spatial/SpatialHashGrid.h"
+
+#include <algorithm>
+
+namespace SPATIAL {
+
+    uint32_t SpatialHashGrid::createProxy(const MATH::AABB &box, uint32_t userData) {
+        uint32_t proxy;
+        if (m_freeProxy == NULL_PROXY) {
+            proxy = static_cast<uint32_t>(m_proxies.size());
+            m_proxies.emplace_back();
+        } else {
+            proxy = m_freeProxy;
+            m_freeProxy = m_proxies[proxy].slot;
+        }
+
+        m_proxies[proxy].box = box;
+        m_proxies[proxy].userData = userData;
+        link(proxy);
+        ++m_proxyCount;
+        return proxy;
+    }
+
+    void SpatialHashGrid::destroyProxy(uint32_t proxy) {
+        unlink(proxy);
+        m_proxies[proxy].cell = NULL_PROXY;
+        m_proxies[proxy].slot = m_freeProxy;
+        m_freeProxy = proxy;
+        --m_proxyCount;
+    }
+
+    bool SpatialHashGrid::moveProxy(uint32_t proxy, const MATH::AABB &box) {
+        Proxy& p = m_proxies[proxy];
+        const uint32_t oldCell = p.cell;
+        p.box = box;
+
+        // same cell (or still too big for one): nothing to relink
+        if (fitsCell(box)) {
+            if (oldCell != OVERFLOW_CELL && m_cells[oldCell].coords == cellCoords(box.getCenter())) return false;
+        } else if (oldCell == OVERFLOW_CELL) {
+            return false;
+        }
+
+        unlink(proxy);
+        link(proxy);
+        return true;
+    }
+
+    void SpatialHashGrid::clear() {
+        m_proxies.clear();
+        m_freeProxy = NULL_PROXY;
+        m_proxyCount = 0;
+        m_cellIndex.clear();
+        m_cells.clear();
+        m_freeCells.clear();
+        m_occupied.clear();
+        m_occupiedSlot.clear();
+        m_overflow.clear();
+        m_minCell = glm::ivec3(std::numeric_limits<int>::max());
+        m_maxCell = glm::ivec3(std::numeric_limits<int>::min());
+    }
+
+    QueryHit SpatialHashGrid::raycastClosest(const glm::vec3 &origin, const glm::vec3 &direction, float maxT) const {
+        QueryHit result;
+        raycast(origin, direction, maxT, [&result](uint32_t userData, float tEnter) {
+            result = { userData, tEnter, true };
+            return tEnter;
+        });
+        return result;
+    }
+
+    QueryHit SpatialHashGrid::nearest(const glm::vec3 &point, float maxDistance) const {
+        QueryHit result;
+        float bestDistance = maxDistance < std::numeric_limits<float>::max() ? maxDistance * maxDistance : maxDistance;
+
+        const auto testProxy = [&](uint32_t proxy) {
+            const Proxy& p = m_proxies[proxy];
+            const float distance = p.box.distanceSquared(point);
+            if (distance <= bestDistance) {
+                bestDistance = distance;
+                result = { p.userData, distance, true };
+            }
+        };
+
+        for (const uint32_t proxy : m_overflow) testProxy(proxy);
+        if (m_occupied.empty()) return result;
+
+        // every occupied cell, pruned by its loose box. What the ring search falls back to once it would cost more
+        const auto walkAll = [&] {
+            for (const uint32_t cellIndex : m_occupied) {
+                const Cell& cell = m_cells[cellIndex];
+                if (looseBounds(cell).distanceSquared(point) > bestDistance) continue;
+                for (const uint32_t proxy : cell.proxies) testProxy(proxy);
+            }
+            return result;
+        };
+
+        // too far out for int cell coordinates
+        constexpr float COORD_LIMIT = 1 << 30;
+        const glm::vec3 scaled = glm::abs(point * m_inverseCellSize);
+        if (!(std::max({ scaled.x, scaled.y, scaled.z }) < COORD_LIMIT)) return walkAll();
+
+        /*
+         * Rings of cells around the point's cell, ring r being the cells at Chebyshev distance r. A proxy lies
+         * in the loose box of its cell, so nothing in ring r is closer than (r - 1) * cellSize + edge - cellSize / 2,
+         * edge being the point's distance to the faces of its own cell. Once that bound is past the best hit,
+         * no further ring can hold a closer one.
+         */
+        const glm::ivec3 center = cellCoords(point);
+        const glm::vec3 cellMin = glm::vec3(center) * m_cellSize;
+        const glm::vec3 toFaces = glm::min(point - cellMin, cellMin + glm::vec3(m_cellSize) - point);
+        const float edge = std::max(0.0f, std::min({ toFaces.x, toFaces.y, toFaces.z }));
+        const auto ringBound = [&](int64_t ring) {
+            return std::max(0.0f, (static_cast<float>(ring) - 1.5f) * m_cellSize + edge);
+        };
+
+        // rings short of [m_minCell, m_maxCell] are empty, and none past the one covering it can hold anything
+        int64_t firstRing = 0;
+        int64_t lastRing = 0;
+        for (int axis = 0; axis < 3; ++axis) {
+            const int64_t below = int64_t(m_minCell[axis]) - center[axis];
+            const int64_t above = int64_t(center[axis]) - m_maxCell[axis];
+            firstRing = std::max({ firstRing, below, above });
+            lastRing = std::max({ lastRing, std::abs(below), std::abs(above) });
+        }
+
+        constexpr uint64_t LOOKUP_COST = 8;
+        uint64_t visited = 0;
+        for (int64_t ring = firstRing; ring <= lastRing; ++ring) {
+            const float bound = ringBound(ring);
+            if (bound * bound > bestDistance) return result;
+
+            // (2r+1)^3 - (2r-1)^3 cells, one hash lookup each. A lookup (two likely cache misses) costs about 8 loose box tests of the walk
+            const uint64_t ringCells = ring == 0 ? 1 : 24 * uint64_t(ring) * uint64_t(ring) + 2;
+            if ((visited + ringCells) * LOOKUP_COST > m_occupied.size()) return walkAll();
+            visited += ringCells;
+
+            const int r = static_cast<int>(ring);
+            const auto visit = [&](int x, int y, int z) {
+                const glm::ivec3 coords = center + glm::ivec3(x, y, z);
+                const auto it = m_cellIndex.find(cellKey(coords));
+                if (it == m_cellIndex.end() || m_cells[it->second].coords != coords) return;
+                for (const uint32_t proxy : m_cells[it->second].proxies) testProxy(proxy);
+            };
+            for (int z = -r; z <= r; ++z) {
+                for (int y = -r; y <= r; ++y) {
+                    // inside the shell only the two x faces belong to this ring
+                    if (std::abs(z) == r || std::abs(y) == r) {
+                        for (int x = -r; x <= r; ++x) visit(x, y, z);
+                    } else {
+                        visit(-r, y, z);
+                        visit(r, y, z);
+                    }
+                }
+            }
+        }
+        return result;
+    }
+
+    void SpatialHashGrid::link(uint32_t proxy) {
+        Proxy& p = m_proxies[proxy];
+
+        if (!fitsCell(p.box)) {
+            p.cell = OVERFLOW_CELL;
+            p.slot = static_cast<uint32_t>(m_overflow.size());
+            m_overflow.push_back(proxy);
+            return;
+        }
+
+        const glm::ivec3 coords = cellCoords(p.box.getCenter());
+        const uint64_t key = cellKey(coords);
+
+        auto it = m_cellIndex.find(key);
+        // a different cell under the same key: the newcomer goes to overflow rather than sharing the list
+        if (it != m_cellIndex.end() && m_cells[it->second].coords != coords) {
+            p.cell = OVERFLOW_CELL;
+            p.slot = static_cast<uint32_t>(m_overflow.size());
+            m_overflow.push_back(proxy);
+            return;
+        }
+
+        if (it == m_cellIndex.end()) {
+            uint32_t cellIndex;
+            if (m_freeCells.empty()) {
+                cellIndex = static_cast<uint32_t>(m_cells.size());
+                m_cells.emplace_back();
+                m_occupiedSlot.push_back(0);
+            } else {
+                cellIndex = m_freeCells.back();
+                m_freeCells.pop_back();
+            }
+            m_cells[cellIndex].coords = coords;
+            m_minCell = glm::min(m_minCell, coords);
+            m_maxCell = glm::max(m_maxCell, coords);
+            m_occupiedSlot[cellIndex] = static_cast<uint32_t>(m_occupied.size());
+            m_occupied.push_back(cellIndex);
+            it = m_cellIndex.emplace(key, cellIndex).first;
+        }
+
+        std::vector<uint32_t>& list = m_cells[it->second].proxies;
+        p.cell = it->second;
+        p.slot = static_cast<uint32_t>(list.size());
+        list.push_back(proxy);
+    }
+
+    void SpatialHashGrid::unlink(uint32_t proxy) {
+        const Proxy& p = m_proxies[proxy];
+        std::vector<uint32_t>& list = p.cell == OVERFLOW_CELL ? m_overflow : m_cells[p.cell].proxies;
+
+        // swap-remove, the moved proxy takes over the slot
+        const uint32_t last = list.back();
+        list[p.slot] = last;
+        m_proxies[last].slot = p.slot;
+        list.pop_back();
+
+        if (p.cell == OVERFLOW_CELL || !list.empty()) return;
+
+        // the cell is empty: out of the map and the occupied list, its vector keeps its capacity for reuse
+        const uint32_t cellIndex = p.cell;
+        m_cellIndex.erase(cellKey(m_cells[cellIndex].coords));
+
+        const uint32_t slot = m_occupiedSlot[cellIndex];
+        const uint32_t lastCell = m_occupied.back();
+        m_occupied[slot] = lastCell;
+        m_occupiedSlot[lastCell] = slot;
+        m_occupied.pop_back();
+
+        m_freeCells.push_back(cellIndex);
+    }
+}
@@ -0,0 +1,139 @@
+#include "SystemScheduler.h"
+
+#include <thread>
+#include "core/Logger.h"
+
+struct SystemScheduler::FrameState {
+    FrameState(World& world, float deltaTime, uint32_t firstTick, size_t systemCount)
+        : world(world), deltaTime(deltaTime), firstTick(firstTick),
+          remaining(std::make_unique<std::atomic<uint32_t>[]>(systemCount)), pending(systemCount) {};
+
+    World& world;
+    float deltaTime;
+    // system i runs at tick firstTick + i
+    uint32_t firstTick;
+
+    // unfinished dependencies per system
+    std::unique_ptr<std::atomic<uint32_t>[]> remaining;
+    // systems not finished yet
+    std::atomic<size_t> pending;
+
+    // ready main-thread systems, drained by the thread that called run()
+    std::mutex mainThreadMutex;
+    std::vector<size_t> mainThreadReady;
+};
+
+SystemScheduler::SystemBuilder SystemScheduler::addSystem(const std::string& name) {
+    for (const auto& system : m_systems) {
+        if (system.name == name) {
+            Logger::warn("[SystemScheduler::addSystem] system " + name + " is already registered");
+            break;
+        }
+    }
+
+    m_systems.push_back(System{ .name = name });
+    return SystemBuilder(*this, m_systems.size() - 1);
+}
+
+void SystemScheduler::run(World& world, float deltaTime) {
+    if (m_systems.empty()) {
+        m_commands.playback(world);
+        return;
+    }
+
+    for (const auto& system : m_systems) {
+        for (const auto& prepare : system.preparePools) {
+            prepare(world);
+        }
+    }
+
+    buildGraph();
+
+    // one tick per system, plus one for the command playback after them
+    const uint32_t firstTick = world.advanceTick(static_cast<uint32_t>(m_systems.size()) + 1);
+
+    FrameState frame(world, deltaTime, firstTick, m_systems.size());
+    for (size_t i = 0; i < m_systems.size(); ++i) {
+        frame.remaining[i].store(m_dependencyCounts[i], std::memory_order_relaxed);
+    }
+
+    for (size_t i = 0; i < m_systems.size(); ++i) {
+        if (m_dependencyCounts[i] == 0) launch(frame, i);
+    }
+
+    // the calling thread runs main-thread systems and helps the pool until the frame is done
+    while (frame.pending.load(std::memory_order_acquire) != 0) {
+        size_t index = m_systems.size();
+        {
+            std::lock_guard lock(frame.mainThreadMutex);
+            if (!frame.mainThreadReady.empty()) {
+                index = frame.mainThreadReady.back();
+                frame.mainThreadReady.pop_back();
+            }
+        }
+
+        if (index != m_systems.size()) {
+            execute(frame, index);
+        }
+        else if (!m_pool.runPendingJob()) {
+            std::this_thread::yield();
+        }
+    }
+
+    // sync point: no system is running anymore
+    m_commands.playback(world);
+}
+
+bool SystemScheduler::conflicts(const System& a, const System& b) {
+    if (a.exclusive || b.exclusive) return true;
+
+    return (a.writes & (b.reads | b.writes)).any() || (b.writes & a.reads).any();
+}
+
+void SystemScheduler::buildGraph() {
+    const size_t count = m_systems.size();
+    m_dependents.assign(count, {});
+    m_dependencyCounts.assign(count, 0);
+
+    for (size_t later = 0; later < count; ++later) {
+        for (size_t earlier = 0; earlier < later; ++earlier) {
+            if (conflicts(m_systems[earlier], m_systems[later])) {
+                m_dependents[earlier].push_back(later);
+                ++m_dependencyCounts[later];
+            }
+        }
+    }
+}
+
+void SystemScheduler::launch(FrameState& frame, size_t index) {
+    if (m_systems[index].mainThreadOnly) {
+        std::lock_guard lock(frame.mainThreadMutex);
+        frame.mainThreadReady.push_back(index);
+        return;
+    }
+
+    m_pool.submit([this, &frame, index] { execute(frame, index); });
+}
+
+void SystemScheduler::execute(FrameState& frame, size_t index) {
+    auto& system = m_systems[index];
+    const uint32_t tick = frame.firstTick + static_cast<uint32_t>(index);
+
+    if (system.update) {
+        SystemContext context(m_pool, m_commands, frame.deltaTime, tick, system.lastRunTick);
+        system.update(frame.world, context);
+    }
+    else {
+        Logger::warn("[SystemScheduler::execute] system " + system.name + " has no update function");
+    }
+    system.lastRunTick = tick;
+
+    for (const size_t dependent : m_dependents[index]) {
+        if (frame.remaining[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            launch(frame, dependent);
+        }
+    }
+
+    // dependents are launched before this system counts as finished, so pending can't hit zero early
+    frame.pending.fetch_sub(1, std::memory_order_acq_rel);
+}
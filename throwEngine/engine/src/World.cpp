@@ -3,37 +3,177 @@
 //
 #include "World.h"
 #include "ComponentStorage.h"
-#include "graphics/Camera/CameraComponent.h"
-#include "graphics/Lighting/LightComponent.h"
-#include "graphics/Transformations/TransformComponent.h"
-#include "graphics/Mesh/MeshComponent.h"
-#include "graphics/Material/MaterialComponent.h"
+#include "core/Logger.h"
+
+#include <algorithm>
+#include <bit>
+#include <ranges>
+
+World::World() {
+    // slot 0 backs NullEntity and is never handed out
+    m_entities.push_back(ECS::NullEntity);
+    m_signatures.emplace_back();
+}
 
 void World::deleteEntity(Entity e) {
-    // Delete each component one by one (this is a c++ problem but can be tried later)
-    getStorage<TransformComponent>().remove(e);
-    getStorage<MeshComponent>().remove(e);
-    getStorage<MaterialComponent>().remove(e);
-    getStorage<LightComponent>().remove(e);
-    getStorage<CameraComponent>().remove(e);
+    if (!isAlive(e)) {
+        Logger::warn("[World::deleteEntity] entity " + std::to_string(e) + " is not alive (stale or already deleted)");
+        return;
+    }
+
+    const uint32_t index = ECS::getIndex(e);
+    ECS::Signature& signature = m_signatures[index];
+
+    // only visit the pools this entity actually belongs to, O(k) in its component count
+    // (MAX_COMPONENT_TYPES is 64, so the whole signature fits in one word)
+    const uint64_t bits = signature.to_ullong();
+
+    // groups have to release the entity before any of its components are swapped out
+    for (uint64_t it = bits; it != 0; it &= it - 1) {
+        if (IGroup* owner = m_poolOwners[std::countr_zero(it)]) owner->onComponentRemoved(e);
+    }
+
+    for (uint64_t it = bits; it != 0; it &= it - 1) {
+        m_pools[std::countr_zero(it)]->remove(e);
+    }
+    signature.reset();
+
+    // a free slot only keeps its next generation (with index 0, so no live handle can match it)
+    m_entities[index] = ECS::makeEntity(0, ECS::getGeneration(e) + 1);
+    m_freeIndices.push_back(index);
 }
 
-template<typename T>
-void World::addComponent(Entity e, T c) {
-    getStorage<T>().add(e, std::move(c));
+Entity World::createEntity() {
+    if (!m_freeIndices.empty()) {
+        const uint32_t index = m_freeIndices.back();
+        m_freeIndices.pop_back();
+        m_entities[index] = ECS::makeEntity(index, ECS::getGeneration(m_entities[index]));
+        return m_entities[index];
+    }
+
+    const auto index = static_cast<uint32_t>(m_entities.size());
+    if (index > ECS::ENTITY_INDEX_MASK) {
+        Logger::error("[World::createEntity] entity index space exhausted!");
+        return ECS::NullEntity;
+    }
+
+    const Entity e = ECS::makeEntity(index, 0);
+    m_entities.push_back(e);
+    m_signatures.emplace_back();
+    return e;
 }
 
-template<typename T>
-T *World::getComponent(Entity e) {
-    return getStorage<T>().get(e);
+uint32_t World::advanceTick(uint32_t count) {
+    const uint32_t first = m_tick + 1;
+    m_tick += count;
+    return first;
 }
 
-template<typename T>
-ComponentStorage<T> &World::getStorage() {
-    static ComponentStorage<T> storage;
-    return storage;
+void World::reserveEntities(size_t count) {
+    if (count <= m_freeIndices.size()) return;
+
+    const size_t appended = count - m_freeIndices.size();
+    m_entities.reserve(m_entities.size() + appended);
+    m_signatures.reserve(m_signatures.size() + appended);
 }
 
-Entity World::createEntity() {
-    return nextID++;
+bool World::isAlive(Entity e) const {
+    const uint32_t index = ECS::getIndex(e);
+    if (index == 0 || index >= m_entities.size()) return false;
+
+    return m_entities[index] == e;
+}
+
+std::vector<Entity> World::merge(World&& other) {
+    std::vector<Entity> remap(other.m_entities.size(), ECS::NullEntity);
+
+    // fast path: this world never handed out a handle, take the other world over as a whole (handles stay valid)
+    if (m_entities.size() == 1 && m_groups.empty()) {
+        for (uint32_t index = 1; index < other.m_entities.size(); ++index) {
+            if (ECS::getIndex(other.m_entities[index]) == index) remap[index] = other.m_entities[index];
+        }
+        // keep our clock, consumers remember ticks of this world
+        const uint32_t tick = m_tick;
+        *this = std::move(other);
+        other = World();
+
+        m_tick = tick;
+        for (const auto& pool : m_pools) {
+            if (pool) pool->stampTicks(m_tick);
+        }
+        return remap;
+    }
+
+    if (getAliveCount() == 0 && m_groups.empty()) {
+        // nothing alive: imported entities keep their slot index. A slot both worlds used takes the newer
+        // generation, a free slot of ours already holds the next one, so no handle we gave out matches again
+        if (m_entities.size() < other.m_entities.size()) {
+            m_entities.resize(other.m_entities.size(), ECS::NullEntity);
+            m_signatures.resize(other.m_entities.size());
+        }
+        for (uint32_t index = 1; index < other.m_entities.size(); ++index) {
+            const Entity theirs = other.m_entities[index];
+            const uint32_t generation = std::max(ECS::getGeneration(m_entities[index]), ECS::getGeneration(theirs));
+            if (ECS::getIndex(theirs) != index) {
+                m_entities[index] = ECS::makeEntity(0, generation);
+                continue;
+            }
+            m_entities[index] = ECS::makeEntity(index, generation);
+            m_signatures[index] = other.m_signatures[index];
+            remap[index] = m_entities[index];
+        }
+
+        // every slot that is still free, highest first so low indices are handed out first
+        m_freeIndices.clear();
+        for (auto index = static_cast<uint32_t>(m_entities.size() - 1); index >= 1; --index) {
+            if (ECS::getIndex(m_entities[index]) != index) m_freeIndices.push_back(index);
+        }
+    } else {
+        // all or nothing: a partial import would leave components of other without an entity here
+        const size_t available = m_freeIndices.size() + (size_t(ECS::ENTITY_INDEX_MASK) + 1 - m_entities.size());
+        if (other.getAliveCount() > available) {
+            Logger::error("[World::merge] entity index space exhausted, " + std::to_string(other.getAliveCount() - available) +
+                " of " + std::to_string(other.getAliveCount()) + " entities don't fit, nothing was merged");
+            std::ranges::fill(remap, ECS::NullEntity);
+            return remap;
+        }
+
+        // allocate handles for every live entity of other, in one pass
+        reserveEntities(other.getAliveCount());
+
+        for (uint32_t index = 1; index < other.m_entities.size(); ++index) {
+            if (ECS::getIndex(other.m_entities[index]) != index) continue; // free slot
+
+            const Entity e = createEntity();
+            remap[index] = e;
+            m_signatures[ECS::getIndex(e)] = other.m_signatures[index];
+        }
+    }
+
+    // splice pool by pool, each one is a bulk append into a reserved dense array
+    if (other.m_pools.size() > m_pools.size()) {
+        m_pools.resize(other.m_pools.size());
+    }
+    for (size_t type = 0; type < other.m_pools.size(); ++type) {
+        auto& source = other.m_pools[type];
+        if (!source || source->size() == 0) continue;
+
+        if (!m_pools[type]) {
+            m_pools[type] = source->createEmpty();
+        }
+        m_pools[type]->mergeFrom(*source, remap, m_tick);
+    }
+
+    // pull imported entities into the packed ranges of our groups
+    if (!m_groups.empty()) {
+        for (const Entity e : remap) {
+            if (e == ECS::NullEntity) continue;
+            for (const auto& group : m_groups | std::views::values) {
+                group->onComponentAdded(e);
+            }
+        }
+    }
+
+    other = World();
+    return remap;
 }
@@ -0,0 +1,327 @@
+#include "WorldSnapshot.h"
+
+#include <cstring>
+#include <fstream>
+#include "core/Logger.h"
+
+#if defined(_WIN32)
+    #include <vector>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace {
+    constexpr char MAGIC[8] = { 'T', 'H', 'R', 'W', 'S', 'N', 'A', 'P' };
+    constexpr uint64_t BLOB_ALIGNMENT = 16;
+
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t slotCount;
+        uint32_t freeCount;
+        uint32_t poolCount;
+        uint32_t tick;
+        uint32_t reserved;
+        uint64_t fileSize;
+    };
+
+    struct PoolEntry {
+        uint64_t typeHash;
+        uint32_t componentSize;
+        uint32_t count;
+        uint64_t entitiesOffset;
+        uint64_t componentsOffset;
+    };
+
+    uint64_t alignUp(uint64_t offset) {
+        return (offset + BLOB_ALIGNMENT - 1) / BLOB_ALIGNMENT * BLOB_ALIGNMENT;
+    }
+
+    // slot 0 is NullEntity, a live slot holds its own index, a free slot holds index 0 and is listed exactly once
+    // in the free table. createEntity() and getAliveCount() trust both tables, so nothing else may get through
+    bool validEntityTables(const std::vector<Entity>& slots, const std::vector<uint32_t>& freeIndices) {
+        if (slots.empty() || slots[0] != ECS::NullEntity || freeIndices.size() >= slots.size()) return false;
+
+        size_t freeSlots = 0;
+        for (uint32_t index = 1; index < slots.size(); ++index) {
+            const uint32_t slotIndex = ECS::getIndex(slots[index]);
+            if (slotIndex == 0) ++freeSlots;
+            else if (slotIndex != index) return false;
+        }
+
+        std::vector<bool> listed(slots.size(), false);
+        for (const uint32_t index : freeIndices) {
+            if (index == 0 || index >= slots.size() || listed[index] || ECS::getIndex(slots[index]) != 0) return false;
+            listed[index] = true;
+        }
+        // a free slot missing from the table would never be reused and would count as alive
+        return freeSlots == freeIndices.size();
+    }
+
+    // read-only view of a whole file, mmap on POSIX, a plain read into memory on Windows
+    class MappedFile {
+    public:
+        explicit MappedFile(const std::string& path);
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        [[nodiscard]] bool isOpen() const { return m_data != nullptr; };
+        [[nodiscard]] const std::byte* data() const { return m_data; };
+        [[nodiscard]] size_t size() const { return m_size; };
+
+    private:
+        const std::byte* m_data = nullptr;
+        size_t m_size = 0;
+#if defined(_WIN32)
+        std::vector<std::byte> m_buffer;
+#endif
+    };
+
+#if defined(_WIN32)
+    MappedFile::MappedFile(const std::string& path) {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) return;
+
+        m_buffer.resize(static_cast<size_t>(file.tellg()));
+        file.seekg(0, std::ios::beg);
+        if (m_buffer.empty() || !file.read(reinterpret_cast<char*>(m_buffer.data()), static_cast<std::streamsize>(m_buffer.size()))) return;
+
+        m_data = m_buffer.data();
+        m_size = m_buffer.size();
+    }
+
+    MappedFile::~MappedFile() = default;
+#else
+    MappedFile::MappedFile(const std::string& path) {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return;
+
+        struct stat info {};
+        if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+            void* mapped = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped != MAP_FAILED) {
+                // every byte is read once, front to back
+                ::madvise(mapped, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+                m_data = static_cast<const std::byte*>(mapped);
+                m_size = static_cast<size_t>(info.st_size);
+            }
+        }
+        ::close(fd);
+    }
+
+    MappedFile::~MappedFile() {
+        if (m_data) ::munmap(const_cast<std::byte*>(m_data), m_size);
+    }
+#endif
+}
+
+std::vector<WorldSnapshot::TypeInfo>& WorldSnapshot::registry() {
+    static std::vector<TypeInfo> types;
+    return types;
+}
+
+uint64_t WorldSnapshot::hashName(std::string_view name) {
+    // FNV-1a, stable across builds and platforms
+    uint64_t hash = 14695981039346656037ull;
+    for (const char c : name) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+void WorldSnapshot::addType(const TypeInfo& info, std::string_view name) {
+    if (const TypeInfo* existing = findByHash(info.hash)) {
+        if (existing->typeID != info.typeID) {
+            Logger::error("[WorldSnapshot::registerType] name " + std::string(name) + " is already used by another component type");
+        }
+        return;
+    }
+    registry().push_back(info);
+}
+
+const WorldSnapshot::TypeInfo* WorldSnapshot::findByHash(uint64_t hash) {
+    for (const auto& info : registry()) {
+        if (info.hash == hash) return &info;
+    }
+    return nullptr;
+}
+
+const WorldSnapshot::TypeInfo* WorldSnapshot::findByTypeID(ECS::ComponentTypeID typeID) {
+    for (const auto& info : registry()) {
+        if (info.typeID == typeID) return &info;
+    }
+    return nullptr;
+}
+
+bool WorldSnapshot::save(const World& world, const std::string& path) {
+    // pools that go into the file, with their layout
+    std::vector<PoolEntry> entries;
+    std::vector<const IComponentStorage*> pools;
+    for (ECS::ComponentTypeID type = 0; type < world.m_pools.size(); ++type) {
+        const auto& pool = world.m_pools[type];
+        if (!pool || pool->size() == 0) continue;
+
+        const TypeInfo* info = findByTypeID(type);
+        if (!info) continue; // not registered, not persistent
+
+        entries.push_back(PoolEntry{ info->hash, info->componentSize, static_cast<uint32_t>(pool->size()), 0, 0 });
+        pools.push_back(pool.get());
+    }
+
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.slotCount = static_cast<uint32_t>(world.m_entities.size());
+    header.freeCount = static_cast<uint32_t>(world.m_freeIndices.size());
+    header.poolCount = static_cast<uint32_t>(entries.size());
+    header.tick = world.m_tick;
+
+    const uint64_t slotsOffset = alignUp(sizeof(Header));
+    const uint64_t freeOffset = alignUp(slotsOffset + header.slotCount * sizeof(Entity));
+    const uint64_t tableOffset = alignUp(freeOffset + header.freeCount * sizeof(uint32_t));
+    uint64_t offset = alignUp(tableOffset + entries.size() * sizeof(PoolEntry));
+    for (auto& entry : entries) {
+        entry.entitiesOffset = offset;
+        entry.componentsOffset = alignUp(offset + uint64_t(entry.count) * sizeof(Entity));
+        offset = alignUp(entry.componentsOffset + uint64_t(entry.count) * entry.componentSize);
+    }
+    header.fileSize = offset;
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        Logger::error("[WorldSnapshot::save] could not open " + path);
+        return false;
+    }
+
+    const auto writeAt = [&file](uint64_t position, const void* data, size_t bytes) {
+        // zero padding up to position, then the block itself in one write
+        static constexpr char padding[BLOB_ALIGNMENT] = {};
+        const auto current = static_cast<uint64_t>(file.tellp());
+        file.write(padding, static_cast<std::streamsize>(position - current));
+        if (bytes) file.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+    };
+
+    writeAt(0, &header, sizeof(Header));
+    writeAt(slotsOffset, world.m_entities.data(), world.m_entities.size() * sizeof(Entity));
+    writeAt(freeOffset, world.m_freeIndices.data(), world.m_freeIndices.size() * sizeof(uint32_t));
+    writeAt(tableOffset, entries.data(), entries.size() * sizeof(PoolEntry));
+    for (size_t i = 0; i < entries.size(); ++i) {
+        writeAt(entries[i].entitiesOffset, pools[i]->getEntities().data(), entries[i].count * sizeof(Entity));
+        writeAt(entries[i].componentsOffset, pools[i]->getRawComponents(), size_t(entries[i].count) * entries[i].componentSize);
+    }
+    writeAt(header.fileSize, nullptr, 0);
+
+    if (!file) {
+        Logger::error("[WorldSnapshot::save] writing " + path + " failed");
+        return false;
+    }
+    return true;
+}
+
+bool WorldSnapshot::load(World& world, const std::string& path) {
+    const MappedFile file(path);
+    if (!file.isOpen()) {
+        Logger::error("[WorldSnapshot::load] could not open " + path);
+        return false;
+    }
+
+    Header header{};
+    if (file.size() < sizeof(Header)) {
+        Logger::error("[WorldSnapshot::load] " + path + " is too small to be a snapshot");
+        return false;
+    }
+    std::memcpy(&header, file.data(), sizeof(Header));
+
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION) {
+        Logger::error("[WorldSnapshot::load] " + path + " is not a version " + std::to_string(VERSION) + " snapshot");
+        return false;
+    }
+    if (header.fileSize != file.size() || header.slotCount == 0) {
+        Logger::error("[WorldSnapshot::load] " + path + " is truncated or corrupt");
+        return false;
+    }
+
+    const auto inBounds = [&file](uint64_t offset, uint64_t bytes) {
+        return offset <= file.size() && bytes <= file.size() - offset;
+    };
+
+    const uint64_t slotsOffset = alignUp(sizeof(Header));
+    const uint64_t freeOffset = alignUp(slotsOffset + header.slotCount * sizeof(Entity));
+    const uint64_t tableOffset = alignUp(freeOffset + header.freeCount * sizeof(uint32_t));
+    if (!inBounds(tableOffset, uint64_t(header.poolCount) * sizeof(PoolEntry))) {
+        Logger::error("[WorldSnapshot::load] " + path + " has an invalid layout");
+        return false;
+    }
+
+    World loaded;
+    loaded.m_tick = header.tick;
+
+    loaded.m_entities.resize(header.slotCount);
+    std::memcpy(loaded.m_entities.data(), file.data() + slotsOffset, header.slotCount * sizeof(Entity));
+    loaded.m_freeIndices.resize(header.freeCount);
+    std::memcpy(loaded.m_freeIndices.data(), file.data() + freeOffset, header.freeCount * sizeof(uint32_t));
+    if (!validEntityTables(loaded.m_entities, loaded.m_freeIndices)) {
+        Logger::error("[WorldSnapshot::load] " + path + " has an inconsistent entity table");
+        return false;
+    }
+    loaded.m_signatures.assign(header.slotCount, ECS::Signature{});
+
+    std::vector<PoolEntry> entries(header.poolCount);
+    std::memcpy(entries.data(), file.data() + tableOffset, entries.size() * sizeof(PoolEntry));
+
+    for (const auto& entry : entries) {
+        const TypeInfo* info = findByHash(entry.typeHash);
+        if (!info) {
+            Logger::warn("[WorldSnapshot::load] skipping a pool of an unregistered component type");
+            continue;
+        }
+        if (info->componentSize != entry.componentSize) {
+            Logger::error("[WorldSnapshot::load] component size changed since the snapshot was written");
+            return false;
+        }
+        if (!inBounds(entry.entitiesOffset, uint64_t(entry.count) * sizeof(Entity)) ||
+            !inBounds(entry.componentsOffset, uint64_t(entry.count) * entry.componentSize)) {
+            Logger::error("[WorldSnapshot::load] " + path + " has an invalid pool blob");
+            return false;
+        }
+        if (info->typeID < loaded.m_pools.size() && loaded.m_pools[info->typeID]) {
+            Logger::error("[WorldSnapshot::load] " + path + " has two pools of the same component type");
+            return false;
+        }
+
+        // copied out of the mapping and validated before the pool sees it
+        std::vector<Entity> entities(entry.count);
+        std::memcpy(entities.data(), file.data() + entry.entitiesOffset, entry.count * sizeof(Entity));
+
+        for (const Entity e : entities) {
+            const uint32_t index = ECS::getIndex(e);
+            if (index == 0 || index >= header.slotCount || loaded.m_entities[index] != e) {
+                Logger::error("[WorldSnapshot::load] " + path + " references a dead entity");
+                return false;
+            }
+            // the signature bit doubles as the seen-set, a sparse slot can only back one dense entry
+            if (loaded.m_signatures[index].test(info->typeID)) {
+                Logger::error("[WorldSnapshot::load] " + path + " lists an entity twice in one pool");
+                return false;
+            }
+            loaded.m_signatures[index].set(info->typeID);
+        }
+
+        if (info->typeID >= loaded.m_pools.size()) {
+            loaded.m_pools.resize(info->typeID + 1);
+        }
+        loaded.m_pools[info->typeID] = info->createPool();
+        if (!loaded.m_pools[info->typeID]->loadRaw(entities.data(), file.data() + entry.componentsOffset, entry.count, loaded.m_tick)) {
+            return false;
+        }
+    }
+
+    world = std::move(loaded);
+    return true;
+}
@@ -10,6 +10,9 @@
 
 #include "graphics/Transformations/Transformations.h"
 
+#include "graphics/Transformations/TransformPool.h"
+#include "graphics/Transformations/TransformComponent.h"
+
 #include "graphics/Renderer/RenderData.h"
 
 #include "graphics/Textures/Textures.h"
@@ -28,6 +31,8 @@
 #include <Input/Input.h>
 
 #include "core/Logger.h"
+
+#include "Math/SIMD.h"
 // preprocessors
 #define DEBUG_PTR(ptr) DEBUG::DebugForEngineObjectPointers(ptr)
 
@@ -53,6 +58,8 @@ namespace core {
 
 		Logger::info("Starting engine...");
 
+		double lastFrameTime = glfwGetTime();
+
 		// engine life loop
 		while (!glfwWindowShouldClose(window) && !m_RequestShutdown)
 		{
@@ -62,9 +69,19 @@ namespace core {
 
 			Input::update();
 
+			// input moves objects (e.g. the orbiting light), it has to land before transforms are propagated
+			scene->updateInputComponents();
+
+			const double currentFrameTime = glfwGetTime();
+			m_scheduler->run(*m_world, static_cast<float>(currentFrameTime - lastFrameTime));
+			lastFrameTime = currentFrameTime;
+
+			// world matrices are final for this frame, bring the scene's BVH up to date before picking/drawing
+			scene->updateSpatialIndex();
+
 			m_imGuiLayer->BeginFrame();
 
-			rendererManager->draw(scene, cameraManager->getViewMatrix(), cameraManager->getProjectionMatrix());
+			rendererManager->draw(scene);
 
 			m_RequestShutdown = m_imGuiLayer->imGuiImplementations(scene);
 
@@ -103,6 +120,11 @@ namespace core {
 	void Engine::initPointerObjects()
 	{
 		try {
+			if (!MATH::SIMD::kernelsSupported()) {
+				Logger::error("Engine::initPointerObjects FAILED because the SIMD kernels were built with AVX and this CPU has none!");
+				throw std::runtime_error("Engine built with THROW_ENABLE_AVX needs an AVX CPU!");
+			}
+
 			initWindow();
 			initCallBack();
 			initShader();
@@ -116,6 +138,7 @@ namespace core {
 			initScene();
 			initGrid();
 			initLighting();
+			initSystems();
 
 			Logger::info("Engine initPointerObjects successful!");
 		}
@@ -231,6 +254,8 @@ namespace core {
 			throw std::runtime_error("Failed to initialize renderData!");
 		}
 
+		renderData->setTransformPool(std::make_shared<Graphics::TransformPool>());
+
 		rendererManager = std::make_unique<Graphics::Renderer>(renderData);
 
 		if (!rendererManager) {
@@ -265,7 +290,10 @@ namespace core {
 
 	void Engine::initScene()
 	{
-		scene = std::make_shared<SCENE::Scene>(meshData3D, dataInputContext);
+		// scene objects are entities of the engine's World, systems see them like any other entity
+		m_world = std::make_unique<World>();
+
+		scene = std::make_shared<SCENE::Scene>(*m_world, renderData->getTransformPool(), meshData3D, dataInputContext);
 
 		if (!scene) {
 			Logger::warn("[Engine::initScene] scene is nullptr!");
@@ -311,6 +339,28 @@ namespace core {
 		renderData->setLightManager(lightManager);
 	}
 
+	void Engine::initSystems()
+	{
+		// 0 = one worker per hardware thread, minus the main thread
+		m_threadPool = std::make_unique<core::ThreadPool>();
+
+		m_scheduler = std::make_unique<SystemScheduler>(*m_threadPool);
+
+		if (!m_threadPool || !m_world || !m_scheduler) {
+			Logger::warn("[Engine::initSystems] system objects are nullptr!");
+			throw std::runtime_error("Failed to initialize systems!");
+		}
+
+		rendererManager->setThreadPool(m_threadPool.get());
+
+		// world matrices of every transform modified since last frame, in SIMD blocks spread over the pool
+		m_scheduler->addSystem("TransformUpdate")
+			.writes<TransformComponent>()
+			.run([transformPool = renderData->getTransformPool()](World&, SystemContext& context) {
+				transformPool->updateMatrices(&context.getThreadPool());
+			});
+	}
+
 	void Engine::OpenGLSetUpResources() noexcept
 	{
 		glEnable(GL_DEPTH_TEST);
@@ -0,0 +1,112 @@
+#include "core/NameId.h"
+
+#include <mutex>
+
+#include "core/Logger.h"
+
+namespace core {
+
+	NameId::NameId(std::string_view name) : m_index(StringInterner::get().intern(name).m_index) {}
+
+	NameId NameId::find(std::string_view name) {
+		return StringInterner::get().find(name);
+	}
+
+	const std::string& NameId::str() const {
+		return StringInterner::get().getString(*this);
+	}
+
+	uint64_t NameId::getHash() const {
+		return StringInterner::get().getHash(*this);
+	}
+
+	StringInterner& StringInterner::get()
+	{
+		static StringInterner instance;
+		return instance;
+	}
+
+	StringInterner::StringInterner()
+	{
+		// index 0 is the empty string, it never goes through the lookup map
+		Entry* first = new Entry[CHUNK_SIZE];
+		first[0].hash = hashString({});
+		m_chunks[0].store(first, std::memory_order_release);
+		m_count.store(1, std::memory_order_release);
+	}
+
+	StringInterner::~StringInterner()
+	{
+		for (auto& chunk : m_chunks) delete[] chunk.load(std::memory_order_relaxed);
+	}
+
+	NameId StringInterner::intern(std::string_view string)
+	{
+		if (string.empty()) return {};
+		const Key key{ string, hashString(string) };
+
+		{
+			std::shared_lock lock(m_mutex);
+			if (const auto it = m_lookup.find(key); it != m_lookup.end()) return NameId(it->second);
+		}
+
+		std::unique_lock lock(m_mutex);
+		// another thread may have added it between the two locks
+		if (const auto it = m_lookup.find(key); it != m_lookup.end()) return NameId(it->second);
+
+		const uint32_t index = m_count.load(std::memory_order_relaxed);
+		const uint32_t chunk = index >> CHUNK_BITS;
+		if (chunk >= MAX_CHUNKS) {
+			Logger::error("[StringInterner::intern] string table is full, can't intern " + std::string(string));
+			return {};
+		}
+
+		Entry* entries = m_chunks[chunk].load(std::memory_order_relaxed);
+		if (!entries) {
+			entries = new Entry[CHUNK_SIZE];
+			m_chunks[chunk].store(entries, std::memory_order_release);
+		}
+
+		// the key views the entry's own copy, entries never move
+		Entry& entry = entries[index & (CHUNK_SIZE - 1)];
+		entry.string.assign(string);
+		entry.hash = key.hash;
+		m_lookup.emplace(Key{ entry.string, key.hash }, index);
+
+		m_count.store(index + 1, std::memory_order_release);
+		return NameId(index);
+	}
+
+	NameId StringInterner::find(std::string_view string) const
+	{
+		if (string.empty()) return {};
+		const Key key{ string, hashString(string) };
+
+		std::shared_lock lock(m_mutex);
+		if (const auto it = m_lookup.find(key); it != m_lookup.end()) return NameId(it->second);
+		return {};
+	}
+
+	const std::string& StringInterner::getString(NameId id) const {
+		return entry(id.getIndex()).string;
+	}
+
+	uint64_t StringInterner::getHash(NameId id) const {
+		return entry(id.getIndex()).hash;
+	}
+
+	uint64_t StringInterner::hashString(std::string_view string)
+	{
+		// FNV-1a
+		uint64_t hash = 14695981039346656037ull;
+		for (const char c : string) {
+			hash ^= static_cast<unsigned char>(c);
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+
+	const StringInterner::Entry& StringInterner::entry(uint32_t index) const {
+		return m_chunks[index >> CHUNK_BITS].load(std::memory_order_acquire)[index & (CHUNK_SIZE - 1)];
+	}
+}
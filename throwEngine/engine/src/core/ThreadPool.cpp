@@ -0,0 +1,103 @@
+#include "core/ThreadPool.h"
+
+#include "core/Logger.h"
+
+namespace core {
+
+	namespace {
+		thread_local uint32_t t_workerIndex = 0;
+	}
+
+	ThreadPool::ThreadPool(size_t threadCount)
+	{
+		if (threadCount == 0) {
+			const size_t hardware = std::thread::hardware_concurrency();
+			threadCount = hardware > 1 ? hardware - 1 : 1;
+		}
+
+		m_workers.reserve(threadCount);
+		for (size_t i = 0; i < threadCount; ++i) {
+			m_workers.emplace_back(&ThreadPool::workerLoop, this, static_cast<uint32_t>(i + 1));
+		}
+
+		Logger::info("[ThreadPool] started " + std::to_string(threadCount) + " worker threads");
+	}
+
+	ThreadPool::~ThreadPool()
+	{
+		{
+			std::lock_guard lock(m_mutex);
+			m_stop = true;
+		}
+		m_condition.notify_all();
+
+		for (auto& worker : m_workers) {
+			worker.join();
+		}
+	}
+
+	void ThreadPool::submit(Job job, std::atomic<size_t>* counter)
+	{
+		{
+			std::lock_guard lock(m_mutex);
+			if (counter) {
+				m_jobs.emplace_back([job = std::move(job), counter] {
+					job();
+					counter->fetch_sub(1, std::memory_order_acq_rel);
+				});
+			}
+			else {
+				m_jobs.emplace_back(std::move(job));
+			}
+		}
+		m_condition.notify_one();
+	}
+
+	void ThreadPool::waitFor(const std::atomic<size_t>& counter)
+	{
+		while (counter.load(std::memory_order_acquire) != 0) {
+			if (!runPendingJob()) {
+				// remaining jobs are running on other threads
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	uint32_t ThreadPool::getWorkerIndex()
+	{
+		return t_workerIndex;
+	}
+
+	void ThreadPool::workerLoop(uint32_t workerIndex)
+	{
+		t_workerIndex = workerIndex;
+
+		while (true) {
+			Job job;
+			{
+				std::unique_lock lock(m_mutex);
+				m_condition.wait(lock, [this] { return m_stop || !m_jobs.empty(); });
+
+				if (m_stop && m_jobs.empty()) return;
+
+				job = std::move(m_jobs.front());
+				m_jobs.pop_front();
+			}
+			job();
+		}
+	}
+
+	bool ThreadPool::runPendingJob()
+	{
+		Job job;
+		{
+			std::lock_guard lock(m_mutex);
+			if (m_jobs.empty()) return false;
+
+			job = std::move(m_jobs.front());
+			m_jobs.pop_front();
+		}
+		job();
+		return true;
+	}
+}
@@ -30,8 +30,7 @@ namespace GRID
 
 		shaderProgram->bind();
 
-		// Set required uniforms
-		shaderProgram->setVec3("u_cameraPos", m_camera->getCameraPosition());
+		// Set required uniforms, the camera is in the FrameData block
 		shaderProgram->setFloat("u_fadeStart", 50.0f);
 		shaderProgram->setFloat("u_fadeEnd", 100.0f);
 
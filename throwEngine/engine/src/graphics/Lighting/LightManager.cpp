@@ -14,35 +14,44 @@
 
 #define DEBUG_PTR(ptr) DEBUG::DebugForEngineObjectPointers(ptr)
 
+namespace
+{
+    const core::NameId ACTIVE_LIGHT_COUNT("activeLightCount");
+}
+
 namespace LIGHTING
 {
-    void LightManager::setLightUniforms(const std::shared_ptr<SHADER::GLShaderProgram> &shader, size_t index,
+    bool LightManager::setLightUniforms(const std::shared_ptr<SHADER::GLShaderProgram> &shader, size_t index,
         const std::shared_ptr<Light>& light)
     {
         const auto lightData = light->getLightData();
-        if (!lightData) {
-            removeLight(light->getVisual()->getName());
-            return;
-        }
-        const std::string prefix = "lights[" + std::to_string(index) + "]";
-        const std::string name = light->getVisual()->getName();
+        if (!lightData) return false;
+
+        const LightUniformNames& uniforms = getUniformNames(index);
+        const std::string& name = light->getVisual().getName();
+
+        // handle lookups are table hits, unchanged values are skipped by the program
+        const SHADER::UniformHandle position = shader->getUniformHandle(uniforms.position);
+        const SHADER::UniformHandle direction = shader->getUniformHandle(uniforms.direction);
+        const SHADER::UniformHandle diffuse = shader->getUniformHandle(uniforms.diffuse);
+        const SHADER::UniformHandle specular = shader->getUniformHandle(uniforms.specular);
 
         // Position and direction
-        shader->hasUniform(prefix + ".position")
-            ? shader->setVec3(prefix + ".position", lightData->getPosition())
+        position.isValid()
+            ? shader->set(position, lightData->getPosition())
             : Logger::warn("[LightManager::uploadLights] shader has no position uniform!" + name);
 
-        shader->hasUniform(prefix + ".direction")
-            ? shader->setVec3(prefix + ".direction", lightData->getDirection())
+        direction.isValid()
+            ? shader->set(direction, lightData->getDirection())
             : Logger::warn("[LightManager::uploadLights] shader has no direction uniform!" + name);
 
         // Colors
-        shader->hasUniform(prefix + ".diffuse")
-            ? shader->setVec3(prefix + ".diffuse", lightData->getDiffuse())
+        diffuse.isValid()
+            ? shader->set(diffuse, lightData->getDiffuse())
             : Logger::warn("[LightManager::uploadLights] shader has no diffuse uniform!" + name);
 
-        shader->hasUniform(prefix + ".specular")
-            ? shader->setVec3(prefix + ".specular", lightData->getSpecular())
+        specular.isValid()
+            ? shader->set(specular, lightData->getSpecular())
             : Logger::warn("[LightManager::uploadLights] shader has no specular uniform!" + name);
 
         // Attenuation
@@ -71,9 +80,7 @@ namespace LIGHTING
         //     ? shader->setInt(prefix + ".type", static_cast<int>(light->getType()))
         //     : Logger::warn("[LightManager::uploadLights] shader has no type uniform!");
 
-        shader->hasUniform("activeLightCount")
-        ? shader->setUint("activeLightCount", getActiveLightCount())
-        : Logger::warn("[LightManager::uploadLights] shader has no activeLightCount uniform!");
+        return true;
     }
 
     void LightManager::uploadLights(const std::shared_ptr<SHADER::GLShaderProgram>& shader)
@@ -85,59 +92,77 @@ namespace LIGHTING
         // bind shader
         shader->bind();
 
-        for (size_t i = 0; i < m_lights.size(); ++i) {
-            auto& light = m_lights[i];
+        // lights without data are dropped after the loop, removeLight() swaps m_lights under the index.
+        // Uploaded lights are packed into slots 0..uploaded-1, so the shader never sees a gap
+        std::vector<SCENE::SceneHandle> deadLights;
+        uint32_t uploaded = 0;
+        for (const auto& light : m_lights) {
             if (!light) {
                 Logger::warn("[LightManager::uploadLights] Light nullptr!");
-
-                return;
+                continue;
             }
 
             light->update(light);
-            setLightUniforms(shader, i, light);
+            if (setLightUniforms(shader, uploaded, light)) ++uploaded;
+            else deadLights.push_back(light->getVisual().getHandle());
         }
+
+        for (const SCENE::SceneHandle handle : deadLights) removeLight(handle);
+
+        // set even without lights, the program keeps the last count otherwise
+        const SHADER::UniformHandle activeLightCount = shader->getUniformHandle(ACTIVE_LIGHT_COUNT);
+        activeLightCount.isValid()
+        ? shader->set(activeLightCount, static_cast<uint>(uploaded))
+        : Logger::warn("[LightManager::uploadLights] shader has no activeLightCount uniform!");
     }
 
-    bool LightManager::checkLightExists(const std::string &name) const {
-        return m_lightMap.contains(name);
+    const LightManager::LightUniformNames& LightManager::getUniformNames(size_t index) {
+        while (m_uniformNames.size() <= index) {
+            const std::string prefix = "lights[" + std::to_string(m_uniformNames.size()) + "]";
+            m_uniformNames.push_back({
+                .position = core::NameId(prefix + ".position"),
+                .direction = core::NameId(prefix + ".direction"),
+                .diffuse = core::NameId(prefix + ".diffuse"),
+                .specular = core::NameId(prefix + ".specular"),
+            });
+        }
+        return m_uniformNames[index];
+    }
+
+    bool LightManager::checkLightExists(SCENE::SceneHandle handle) const {
+        return m_lightIndex.contains(handle);
     }
 
     void LightManager::addLight(const std::shared_ptr<Light>& light) {
-        const auto& name = light->getVisual()->getName();
-        if (m_lightMap.contains(name)) {
-            removeLight(name);
+        const auto handle = light->getVisual().getHandle();
+        if (m_lightIndex.contains(handle)) {
+            removeLight(handle);
         }
 
-        if (m_NullIndexStackOfLights.empty()) {
-            m_lights.push_back(light);
-            getFreeIndexWithName[name] = m_lights.size() - 1;
-        } else {
-            m_lights[m_NullIndexStackOfLights.top()] = light;
-            getFreeIndexWithName[name] = m_NullIndexStackOfLights.top();
-            m_NullIndexStackOfLights.pop();
-        }
-        m_lightMap[name] = light;
+        m_lightIndex[handle] = static_cast<uint32_t>(m_lights.size());
+        m_lights.push_back(light);
     }
 
-    void LightManager::removeLight(const std::string& name) {
-        const auto it = getFreeIndexWithName.find(name);
-        if (it == getFreeIndexWithName.end()) return;
-
-        uint32_t index = it->second;
-        if (m_lights.size() > index && m_lights[index]) {
-            std::cout << m_lights[index]->getLightData().use_count() << "\n";
-            m_lights[index].reset();
-            m_lightMap.erase(name);
-            m_NullIndexStackOfLights.push(index);
-            getFreeIndexWithName.erase(it);
+    void LightManager::removeLight(SCENE::SceneHandle handle) {
+        const auto it = m_lightIndex.find(handle);
+        if (it == m_lightIndex.end()) return;
+
+        // keep m_lights dense, the last light moves into the freed slot
+        const uint32_t index = it->second;
+        m_lightIndex.erase(it);
+
+        if (index != m_lights.size() - 1) {
+            m_lights[index] = std::move(m_lights.back());
+            m_lightIndex[m_lights[index]->getVisual().getHandle()] = index;
         }
+        m_lights.pop_back();
     }
 
-    std::shared_ptr<Light> LightManager::getLight(const std::string &name) const {
-        if (const auto it = m_lightMap.find(name); it != m_lightMap.end()) {
-            return it->second;
+    std::shared_ptr<Light> LightManager::getLight(SCENE::SceneHandle handle) const {
+        if (const auto it = m_lightIndex.find(handle); it != m_lightIndex.end()) {
+            return m_lights[it->second];
         }
-        Logger::warn("[LightManager::getLight] object: " + name + " nullptr!");
+        Logger::warn("[LightManager::getLight] no light for object " + std::to_string(handle.index) + "!");
         return {};
     }
 }
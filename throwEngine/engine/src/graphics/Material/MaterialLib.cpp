@@ -47,7 +47,7 @@ namespace Graphics
 
             auto material = std::make_shared<Material>();
 
-            material->m_name = name;
+            material->m_name = core::NameId(name);
 
             for (int i = 0; i < ambient.size(); i++) {
                 material->m_ambient[i] = ambient[i];
@@ -69,24 +69,27 @@ namespace Graphics
                 material->m_specularTexture = textureManager.getTextureWithName(specularTexName[0]);
             }
 
-            if (!m_materials.contains(name))
-                m_materials.emplace(name, material);
+            m_materials.emplace(material->m_name, material);
         }
         return true;
     }
 
     std::shared_ptr<Graphics::Material> MaterialLibrary::getMaterialByName(const std::string &name) {
-        if (!m_materials.contains(name)) {
-            Logger::warn("Material \"" + name + "\" not found! but returning fallback\n");
-            // return default material
-            return getDefaultMaterial();
+        return getMaterial(core::NameId(name));
+    }
+
+    std::shared_ptr<Graphics::Material> MaterialLibrary::getMaterial(core::NameId name) {
+        if (const auto it = m_materials.find(name); it != m_materials.end()) {
+            return it->second;
         }
-        return m_materials.at(name);
+        Logger::warn("Material \"" + name.str() + "\" not found! but returning fallback\n");
+        // return default material
+        return getDefaultMaterial();
     }
 
     std::shared_ptr<Material> MaterialLibrary::getDefaultMaterial() {
         const auto fallback = std::make_shared<Material>();
-        fallback->m_name = "default";
+        fallback->m_name = core::NameId("default");
         fallback->m_ambient = glm::vec4(0.1f);
         fallback->m_diffuse = glm::vec4(1.0f);
         fallback->m_specular = glm::vec4(1.0f);
@@ -25,6 +25,11 @@ namespace Graphics
 		info.vertexCount = v.size();
 		info.indexCount = i.size();
 
+		// set bounds
+		for (const auto& vertex : v) {
+			info.localBounds.expand(vertex.position);
+		}
+
 		// sum vertices into the all_vertices
 		all_Vertices.insert( all_Vertices.end(), v.begin(), v.end() );
 
@@ -61,5 +66,11 @@ namespace Graphics
 	{
 		objectInfo[name] = info;
 	}
+
+	const SubMeshInfo* MeshData3D::findObjectInfo(const std::string& name) const
+	{
+		const auto it = objectInfo.find(name);
+		return it != objectInfo.end() ? &it->second : nullptr;
+	}
 	
 }
\ No newline at end of file
@@ -3,30 +3,330 @@
 //
 #include "graphics/Mesh/MeshRenderSystem.h"
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+
 #include "World.h"
+#include "Math/AABB.h"
+#include "Math/Frustum.h"
+#include "core/NameId.h"
+#include "core/ThreadPool.h"
 #include "graphics/Camera/Camera.h"
-#include "graphics/Mesh/Mesh3D.h"
-#include "graphics/Mesh/MeshData3D.h"
+#include "graphics/Lighting/LightManager.h"
+#include "graphics/Material/MaterialComponent.h"
+#include "graphics/Material/MaterialLib.h"
 #include "graphics/Mesh/MeshComponent.h"
+#include "graphics/Mesh/MeshData3D.h"
+#include "graphics/Renderer/RenderData.h"
+#include "graphics/Shaders/ShaderInterface.h"
+#include "graphics/Shaders/ShaderProgram.h"
+#include "graphics/Textures/Textures.h"
+#include "graphics/Transformations/TransformComponent.h"
+#include "graphics/Transformations/TransformPool.h"
+#include "core/Logger.h"
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
 
+namespace
+{
+    // per-instance attributes: the model matrix takes four locations (4-7), the normal matrix three (8-10)
+    constexpr GLuint INSTANCE_MODEL_LOCATION = 4;
+    constexpr GLuint INSTANCE_NORMAL_LOCATION = 8;
+    constexpr GLuint INSTANCE_MATERIAL_LOCATION = 11;
+
+    // binding point of the material storage buffer in basic_instanced.frag
+    constexpr GLuint MATERIAL_BUFFER_BINDING = 0;
+
+    // items per culling and key job, below this the whole scene is done on the calling thread.
+    // A multiple of every SIMD width so only the last chunk has a scalar tail
+    constexpr size_t ITEM_CHUNK_SIZE = 4096;
+
+    // resolved to a handle of each program at bind time. Camera matrices come from the FrameData block
+    const core::NameId GLOBAL_AMBIENT_UNIFORM("globalAmbient");
+
+    // transpose(inverse(m)) of the upper 3x3, which is its cofactor matrix over the determinant
+    glm::mat3 normalMatrix(const glm::mat4& model) {
+        const glm::vec3 x(model[0]), y(model[1]), z(model[2]);
+        const glm::vec3 yz = glm::cross(y, z), zx = glm::cross(z, x), xy = glm::cross(x, y);
+        const float determinant = glm::dot(x, yz);
+        // a degenerate (zero scale) matrix keeps the cofactors, its normals are meaningless anyway
+        const float scale = determinant != 0.0f ? 1.0f / determinant : 1.0f;
+        return glm::mat3(yz * scale, zx * scale, xy * scale);
+    }
+
+    // state bound per draw call: shader, textures and the VAO
+    bool sameBindings(const auto& a, const auto& b) {
+        return a.shader == b.shader && a.texture == b.texture && a.specularTexture == b.specularTexture
+            && a.meshData == b.meshData;
+    }
+
+    // what the key's batch bits stand for, only compared when the bits are equal
+    bool sameBatch(const auto& a, const auto& b) {
+        return sameBindings(a, b) && a.indexOffset == b.indexOffset;
+    }
+}
+
 namespace Render
 {
-    void MeshRenderSystem::render(const World &world, const Graphics::Camera &camera) {
+    MeshRenderSystem::~MeshRenderSystem() {
+        for (const auto& vertexArray : m_VAOs | std::views::values) {
+            glDeleteVertexArrays(1, &vertexArray.VAO);
+        }
+        if (m_instanceVBO != 0) glDeleteBuffers(1, &m_instanceVBO);
+        if (m_materialSSBO != 0) glDeleteBuffers(1, &m_materialSSBO);
+        if (m_indirectBuffer != 0) glDeleteBuffers(1, &m_indirectBuffer);
+    }
+
+    void MeshRenderSystem::render(World &world, const Graphics::Camera &camera, Graphics::RenderData &renderData,
+                                  core::ThreadPool *threadPool) {
+        m_drawCallCount = 0;
+        m_culledCount = 0;
+        m_instances.clear();
+        m_batches.clear();
+
+        if (!renderData.getTransformPool()) {
+            Logger::warn("[MeshRenderSystem::render] RenderData has no TransformPool, skipping!");
+            return;
+        }
+
+        gather(world, renderData);
+        if (m_frustumCulling) cull(camera, renderData, threadPool);
+        if (m_items.empty()) return;
+
+        // every bucket becomes one contiguous run, and its instances one contiguous range of the buffer
+        buildQueue(camera, renderData, threadPool);
+        submit(renderData, threadPool);
+    }
+
+    void MeshRenderSystem::gather(World &world, Graphics::RenderData &renderData) {
+        m_items.clear();
+        m_shaderIds.clear();
+        m_materialIds.clear();
+        m_textureIds.clear();
+        m_meshIds.clear();
+
+        const auto transformPool = renderData.getTransformPool();
+        std::shared_ptr<SHADER::IShader> defaultShader;
+
+        world.view<const TransformComponent, MeshComponent, const MaterialComponent>().each(
+            [&](const TransformComponent& transform, MeshComponent& mesh, const MaterialComponent& material) {
+                if (!mesh.meshData || !material.material || !transformPool->isValid(transform.id)) return;
+
+                if (!mesh.subMesh) {
+                    mesh.subMesh = mesh.meshData->findObjectInfo(mesh.subMeshName);
+                    if (!mesh.subMesh) {
+                        Logger::warn("[MeshRenderSystem::gather] no sub-mesh named " + mesh.subMeshName + ", skipping!");
+                        return;
+                    }
+                }
+
+                SHADER::IShader* shader = material.shader.get();
+                if (!shader) {
+                    if (!defaultShader) defaultShader = renderData.getShaderInterface(SHADER::DEFAULT_INSTANCED_SHADER);
+                    shader = defaultShader.get();
+                }
+
+                // the component's texture replaces the material's diffuse texture
+                const Graphics::Texture* texture = material.texture ? material.texture.get() : material.material->m_diffuseTexture.get();
+                const uint32_t materialIndex = m_materialIds.get(material.material.get());
+
+                const uint64_t stateKey = SortKey::makeState(SortKey::Pass::Opaque, m_shaderIds.get(shader),
+                    m_textureIds.get(texture), m_meshIds.get(mesh.subMesh), materialIndex);
+
+                m_items.push_back(DrawItem{
+                    .stateKey = stateKey,
+                    .shader = shader,
+                    .texture = texture,
+                    .specularTexture = material.material->m_specularTexture.get(),
+                    .meshData = mesh.meshData.get(),
+                    .indexOffset = mesh.subMesh->indexOffset,
+                    .indexCount = mesh.subMesh->indexCount,
+                    .transformID = transform.id,
+                    .materialIndex = materialIndex,
+                    .localBounds = &mesh.subMesh->localBounds,
+                });
+            });
+
+        // one entry per distinct material, instances refer to them by materialIndex
+        m_materials.resize(m_materialIds.ids.size());
+        for (const auto& [material, index] : m_materialIds.ids) {
+            m_materials[index] = MaterialData{
+                .ambient = glm::vec4(material->m_ambient, 0.0f),
+                .diffuse = glm::vec4(material->m_diffuse, 0.0f),
+                .specular = glm::vec4(material->m_specular, material->m_shininess),
+            };
+        }
+    }
+
+    void MeshRenderSystem::cull(const Graphics::Camera &camera, Graphics::RenderData &renderData, core::ThreadPool *threadPool) {
+        const size_t count = m_items.size();
+        if (count == 0) return;
+
+        const auto& transformPool = *renderData.getTransformPool();
+        const MATH::Frustum frustum = MATH::Frustum::fromViewProjection(camera.getProjectionMatrix() * camera.getViewMatrix());
+
+        for (auto* array : { &m_centerX, &m_centerY, &m_centerZ, &m_extentX, &m_extentY, &m_extentZ }) {
+            array->resize(count);
+        }
+        m_visible.resize(count);
+
+        // every chunk writes only its own range, items and the pool are only read
+        const auto cullRange = [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                const DrawItem& item = m_items[i];
+                const MATH::AABB bounds = MATH::transformAABB(*item.localBounds, transformPool.getWorldMatrix(item.transformID));
+                const glm::vec3 center = bounds.getCenter();
+                const glm::vec3 extents = bounds.getExtents();
+                m_centerX[i] = center.x; m_centerY[i] = center.y; m_centerZ[i] = center.z;
+                m_extentX[i] = extents.x; m_extentY[i] = extents.y; m_extentZ[i] = extents.z;
+            }
+            MATH::cullAABBs(frustum, &m_centerX[begin], &m_centerY[begin], &m_centerZ[begin],
+                &m_extentX[begin], &m_extentY[begin], &m_extentZ[begin], end - begin, &m_visible[begin]);
+        };
+
+        if (threadPool) threadPool->parallelFor(count, ITEM_CHUNK_SIZE, cullRange);
+        else cullRange(0, count);
+
+        // compact in place, keeps the gather order
+        size_t visibleCount = 0;
+        for (size_t i = 0; i < count; ++i) {
+            if (m_visible[i]) m_items[visibleCount++] = m_items[i];
+        }
+        m_items.resize(visibleCount);
+        m_culledCount = count - visibleCount;
     }
 
-    void MeshRenderSystem::setupVAO(MeshComponent &comp) {
-        if (comp.VAO != 0) return;
+    void MeshRenderSystem::buildQueue(const Graphics::Camera &camera, Graphics::RenderData &renderData, core::ThreadPool *threadPool) {
+        const auto& transformPool = *renderData.getTransformPool();
+        const glm::vec3 eye = camera.getCameraPosition();
+        const glm::vec3 forward = camera.getCamFront();
 
-        auto& subMesh = comp.meshData->getObjectInfo(comp.subMeshName);
+        auto& entries = m_queue.getEntries();
+        entries.resize(m_items.size());
 
-        glGenVertexArrays(1, &comp.VAO);
-        glBindVertexArray(comp.VAO);
+        // depth is the object origin's distance along the view direction, front to back inside a bucket
+        const auto keyRange = [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                const DrawItem& item = m_items[i];
+                const glm::vec3 origin(transformPool.getWorldMatrix(item.transformID)[3]);
+                entries[i] = { item.stateKey | SortKey::depthBits(glm::dot(origin - eye, forward)), static_cast<uint32_t>(i) };
+            }
+        };
 
-        glBindBuffer(GL_ARRAY_BUFFER, comp.meshData->getVBO());
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, comp.meshData->getEBO());
+        if (threadPool) threadPool->parallelFor(m_items.size(), ITEM_CHUNK_SIZE, keyRange);
+        else keyRange(0, m_items.size());
+
+        m_queue.sort(threadPool);
+    }
+
+    void MeshRenderSystem::submit(Graphics::RenderData &renderData, core::ThreadPool *threadPool) {
+        const auto& transformPool = *renderData.getTransformPool();
+        const auto& entries = m_queue.getEntries();
+        m_instances.resize(entries.size());
+
+        // in queue order, so every bucket's instances are one contiguous range
+        const auto instanceRange = [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                const DrawItem& item = m_items[entries[i].item];
+                const glm::mat4& model = transformPool.getWorldMatrix(item.transformID);
+                m_instances[i] = InstanceData{
+                    .model = model,
+                    .normalMatrix = normalMatrix(model),
+                    .materialIndex = item.materialIndex,
+                };
+            }
+        };
+
+        if (threadPool) threadPool->parallelFor(entries.size(), ITEM_CHUNK_SIZE, instanceRange);
+        else instanceRange(0, entries.size());
+
+        uploadInstances();
+        uploadMaterials();
+
+        buildBatches();
+        if (m_multiDrawIndirect) uploadCommands();
+
+        const auto lightManager = renderData.getLightManager();
+        const auto textureManager = renderData.getTextureManager();
+
+        const DrawItem* previous = nullptr;
+        for (size_t batch = 0; batch < m_batches.size();) {
+            const DrawItem& item = *m_batches[batch].item;
+
+            const bool shaderChanged = !previous || previous->shader != item.shader;
+            if (shaderChanged) {
+                item.shader->bind();
+                const auto& program = item.shader->getGLShaderProgram();
+                program->set(program->getUniformHandle(GLOBAL_AMBIENT_UNIFORM), renderData.getGlobalAmbient());
+                if (lightManager) lightManager->uploadLights(program);
+            }
+
+            // material colors are per instance, only the textures are per bucket
+            if (textureManager && (shaderChanged || previous->texture != item.texture || previous->specularTexture != item.specularTexture)) {
+                // an untextured bucket unbinds its units, or it would sample the previous bucket's textures
+                textureManager->bind(item.texture ? item.texture->glID : 0, 0);
+                textureManager->bind(item.specularTexture ? item.specularTexture->glID : 0, 1);
+            }
+
+            if (!previous || previous->meshData != item.meshData) {
+                glBindVertexArray(getVAO(*item.meshData));
+            }
+
+            if (m_multiDrawIndirect) {
+                // the following buckets that bind the same state go into the same call
+                size_t end = batch + 1;
+                while (end < m_batches.size() && sameBindings(*m_batches[end].item, item)) ++end;
+
+                glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT,
+                    reinterpret_cast<void *>(batch * sizeof(DrawElementsIndirectCommand)), static_cast<GLsizei>(end - batch), 0);
+                batch = end;
+            } else {
+                // indices in the shared EBO are already offset by their sub-mesh's vertexOffset
+                glDrawElementsInstancedBaseInstance(GL_TRIANGLES, static_cast<GLsizei>(item.indexCount), GL_UNSIGNED_INT,
+                    reinterpret_cast<void *>(static_cast<uintptr_t>(item.indexOffset) * sizeof(uint32_t)),
+                    static_cast<GLsizei>(m_batches[batch].instanceCount), m_batches[batch].firstInstance);
+                ++batch;
+            }
+            ++m_drawCallCount;
+
+            previous = &item;
+        }
+
+        glBindVertexArray(0);
+    }
+
+    void MeshRenderSystem::buildBatches() {
+        const auto& entries = m_queue.getEntries();
+
+        size_t first = 0;
+        for (size_t i = 1; i <= entries.size(); ++i) {
+            const DrawItem& item = m_items[entries[first].item];
+            if (i < entries.size() && (entries[i].key & SortKey::BATCH_MASK) == (entries[first].key & SortKey::BATCH_MASK)
+                && sameBatch(m_items[entries[i].item], item)) continue;
+
+            m_batches.push_back(Batch{
+                .item = &item,
+                .firstInstance = static_cast<uint32_t>(first),
+                .instanceCount = static_cast<uint32_t>(i - first),
+            });
+            first = i;
+        }
+    }
+
+    uint32_t MeshRenderSystem::getVAO(const Graphics::MeshData3D &meshData) {
+        auto& vertexArray = m_VAOs[&meshData];
+        if (vertexArray.VAO != 0 && vertexArray.VBO == meshData.getVBO() && vertexArray.EBO == meshData.getEBO()) {
+            return vertexArray.VAO;
+        }
+
+        if (vertexArray.VAO == 0) glGenVertexArrays(1, &vertexArray.VAO);
+        glBindVertexArray(vertexArray.VAO);
+
+        glBindBuffer(GL_ARRAY_BUFFER, meshData.getVBO());
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, meshData.getEBO());
 
         glEnableVertexAttribArray(0);
         glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Graphics::Vertex), reinterpret_cast<void *>(offsetof(Graphics::Vertex, position)));
@@ -40,9 +340,80 @@ namespace Render
         glEnableVertexAttribArray(3);
         glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, sizeof(Graphics::Vertex), reinterpret_cast<void *>(offsetof(Graphics::Vertex, texCoords)));
 
-        // Close VAO
-        glBindVertexArray(0);
+        // per-instance data, matrices one column per location. The buffer keeps its name when it grows,
+        // so this binding stays valid
+        glBindBuffer(GL_ARRAY_BUFFER, m_instanceVBO);
+        for (GLuint column = 0; column < 4; ++column) {
+            glEnableVertexAttribArray(INSTANCE_MODEL_LOCATION + column);
+            glVertexAttribPointer(INSTANCE_MODEL_LOCATION + column, 4, GL_FLOAT, GL_FALSE, sizeof(InstanceData),
+                reinterpret_cast<void *>(offsetof(InstanceData, model) + column * sizeof(glm::vec4)));
+            glVertexAttribDivisor(INSTANCE_MODEL_LOCATION + column, 1);
+        }
+        for (GLuint column = 0; column < 3; ++column) {
+            glEnableVertexAttribArray(INSTANCE_NORMAL_LOCATION + column);
+            glVertexAttribPointer(INSTANCE_NORMAL_LOCATION + column, 3, GL_FLOAT, GL_FALSE, sizeof(InstanceData),
+                reinterpret_cast<void *>(offsetof(InstanceData, normalMatrix) + column * sizeof(glm::vec3)));
+            glVertexAttribDivisor(INSTANCE_NORMAL_LOCATION + column, 1);
+        }
+        glEnableVertexAttribArray(INSTANCE_MATERIAL_LOCATION);
+        glVertexAttribIPointer(INSTANCE_MATERIAL_LOCATION, 1, GL_UNSIGNED_INT, sizeof(InstanceData),
+            reinterpret_cast<void *>(offsetof(InstanceData, materialIndex)));
+        glVertexAttribDivisor(INSTANCE_MATERIAL_LOCATION, 1);
+
+        vertexArray.VBO = meshData.getVBO();
+        vertexArray.EBO = meshData.getEBO();
+        return vertexArray.VAO;
+    }
+
+    void MeshRenderSystem::uploadInstances() {
+        if (m_instanceVBO == 0) glGenBuffers(1, &m_instanceVBO);
+        glBindBuffer(GL_ARRAY_BUFFER, m_instanceVBO);
+
+        // grows geometrically, and is orphaned every frame so the driver doesn't wait on last frame's draws
+        if (m_instances.size() > m_instanceCapacity) {
+            m_instanceCapacity = std::max(m_instances.size(), m_instanceCapacity * 2);
+        }
+        glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(m_instanceCapacity * sizeof(InstanceData)), nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(m_instances.size() * sizeof(InstanceData)), m_instances.data());
+    }
+
+    void MeshRenderSystem::uploadCommands() {
+        // baseVertex stays 0, indices in the shared EBO are already offset by their sub-mesh's vertexOffset.
+        // baseInstance selects the bucket's range of the instance buffer like in the direct path
+        m_commands.resize(m_batches.size());
+        for (size_t i = 0; i < m_batches.size(); ++i) {
+            const Batch& batch = m_batches[i];
+            m_commands[i] = DrawElementsIndirectCommand{
+                .count = batch.item->indexCount,
+                .instanceCount = batch.instanceCount,
+                .firstIndex = batch.item->indexOffset,
+                .baseVertex = 0,
+                .baseInstance = batch.firstInstance,
+            };
+        }
+
+        if (m_indirectBuffer == 0) glGenBuffers(1, &m_indirectBuffer);
+        // stays bound for the glMultiDrawElementsIndirect calls of this frame
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_indirectBuffer);
+
+        // same growth and orphaning as the instance buffer
+        if (m_commands.size() > m_commandCapacity) {
+            m_commandCapacity = std::max(m_commands.size(), m_commandCapacity * 2);
+        }
+        glBufferData(GL_DRAW_INDIRECT_BUFFER, static_cast<GLsizeiptr>(m_commandCapacity * sizeof(DrawElementsIndirectCommand)), nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, static_cast<GLsizeiptr>(m_commands.size() * sizeof(DrawElementsIndirectCommand)), m_commands.data());
+    }
+
+    void MeshRenderSystem::uploadMaterials() {
+        if (m_materialSSBO == 0) glGenBuffers(1, &m_materialSSBO);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, m_materialSSBO);
 
-        subMesh.VAO = comp.VAO;
+        // same growth and orphaning as the instance buffer
+        if (m_materials.size() > m_materialCapacity) {
+            m_materialCapacity = std::max(m_materials.size(), m_materialCapacity * 2);
+        }
+        glBufferData(GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptr>(m_materialCapacity * sizeof(MaterialData)), nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, static_cast<GLsizeiptr>(m_materials.size() * sizeof(MaterialData)), m_materials.data());
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, MATERIAL_BUFFER_BINDING, m_materialSSBO);
     }
 }
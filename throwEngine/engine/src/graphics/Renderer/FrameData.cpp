@@ -0,0 +1,33 @@
+#include "graphics/Renderer/FrameData.h"
+
+#include <glad/glad.h>
+
+#include "graphics/Camera/Camera.h"
+
+namespace Render
+{
+	FrameDataBuffer::~FrameDataBuffer()
+	{
+		if (m_buffer != 0) glDeleteBuffers(1, &m_buffer);
+	}
+
+	void FrameDataBuffer::update(const Graphics::Camera& camera, float time, const glm::vec2& viewportSize)
+	{
+		m_data.view = camera.getViewMatrix();
+		m_data.projection = camera.getProjectionMatrix();
+		m_data.viewProjection = m_data.projection * m_data.view;
+		m_data.inverseView = glm::inverse(m_data.view);
+		m_data.inverseProjection = glm::inverse(m_data.projection);
+		m_data.inverseViewProjection = m_data.inverseView * m_data.inverseProjection;
+		m_data.cameraPosition = glm::vec4(camera.getCameraPosition(), time);
+		// a minimized window has a zero-sized framebuffer
+		const glm::vec2 size = glm::max(viewportSize, glm::vec2(1.0f));
+		m_data.viewport = glm::vec4(viewportSize, 1.0f / size);
+
+		if (m_buffer == 0) glGenBuffers(1, &m_buffer);
+		glBindBuffer(GL_UNIFORM_BUFFER, m_buffer);
+		// orphan instead of overwriting storage the previous frame's draws may still read
+		glBufferData(GL_UNIFORM_BUFFER, sizeof(FrameData), &m_data, GL_STREAM_DRAW);
+		glBindBufferBase(GL_UNIFORM_BUFFER, FRAME_DATA_BINDING, m_buffer);
+	}
+}
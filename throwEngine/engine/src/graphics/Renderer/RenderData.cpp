@@ -48,6 +48,11 @@ namespace Graphics
 		return m_shaderManager->getShaderInterface(name);
 	}
 
+	std::shared_ptr<SHADER::IShader> RenderData::getShaderInterface(core::NameId name)
+	{
+		return m_shaderManager->getShaderInterface(name);
+	}
+
 	std::shared_ptr<SHADER::GLShaderProgram>& RenderData::getWrapperGLShader()
 	{
 		return m_shaderManager->getWrapperGLShader();
@@ -0,0 +1,92 @@
+#include "graphics/Renderer/RenderQueue.h"
+
+#include <bit>
+#include <utility>
+
+#include "core/ThreadPool.h"
+
+namespace
+{
+	// entries per histogram/scatter job, smaller queues are sorted on the calling thread
+	constexpr size_t SORT_CHUNK_SIZE = 16384;
+}
+
+namespace Render
+{
+	uint64_t SortKey::depthBits(float viewDistance)
+	{
+		// a positive float's bit pattern is ordered like its value: sign (always 0), 8 exponent bits,
+		// then the top mantissa bits. Behind the camera and NaN count as distance 0
+		const float distance = viewDistance > 0.0f ? viewDistance : 0.0f;
+		return uint64_t(std::bit_cast<uint32_t>(distance) >> (31 - DEPTH_BITS)) << DEPTH_SHIFT;
+	}
+
+	void RenderQueue::sort(core::ThreadPool* threadPool)
+	{
+		m_sortPassCount = 0;
+		const size_t count = m_entries.size();
+		if (count < 2) return;
+
+		const size_t chunkCount = threadPool && count > SORT_CHUNK_SIZE ? (count + SORT_CHUNK_SIZE - 1) / SORT_CHUNK_SIZE : 1;
+		const size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+		m_histograms.resize(chunkCount);
+		m_chunkVarying.resize(chunkCount);
+		m_scratch.resize(count);
+
+		// func(chunk, begin, end) for every chunk, in parallel when there is more than one
+		const auto forEachChunk = [&](auto&& func) {
+			if (chunkCount == 1) {
+				func(size_t(0), size_t(0), count);
+				return;
+			}
+			threadPool->parallelFor(count, chunkSize, [&](size_t begin, size_t end) { func(begin / chunkSize, begin, end); });
+		};
+
+		// bits that differ from the first key anywhere, a byte without any is a pass that can't reorder anything
+		const uint64_t firstKey = m_entries[0].key;
+		forEachChunk([&](size_t chunk, size_t begin, size_t end) {
+			uint64_t varying = 0;
+			for (size_t i = begin; i < end; ++i) varying |= m_entries[i].key ^ firstKey;
+			m_chunkVarying[chunk] = varying;
+		});
+		uint64_t varying = 0;
+		for (const uint64_t chunkVarying : m_chunkVarying) varying |= chunkVarying;
+
+		std::vector<Entry>* source = &m_entries;
+		std::vector<Entry>* destination = &m_scratch;
+
+		for (uint32_t shift = 0; shift < 64; shift += RADIX_BITS) {
+			if ((varying >> shift & (RADIX - 1)) == 0) continue;
+
+			const Entry* in = source->data();
+			Entry* out = destination->data();
+
+			forEachChunk([&](size_t chunk, size_t begin, size_t end) {
+				auto& histogram = m_histograms[chunk];
+				histogram.fill(0);
+				for (size_t i = begin; i < end; ++i) ++histogram[in[i].key >> shift & (RADIX - 1)];
+			});
+
+			// bucket-major, chunk-minor: chunk c's entries of a bucket go right after chunk c-1's, which keeps it stable
+			uint32_t offset = 0;
+			for (uint32_t bucket = 0; bucket < RADIX; ++bucket) {
+				for (auto& histogram : m_histograms) {
+					const uint32_t bucketCount = histogram[bucket];
+					histogram[bucket] = offset;
+					offset += bucketCount;
+				}
+			}
+
+			forEachChunk([&](size_t chunk, size_t begin, size_t end) {
+				auto& offsets = m_histograms[chunk];
+				for (size_t i = begin; i < end; ++i) out[offsets[in[i].key >> shift & (RADIX - 1)]++] = in[i];
+			});
+
+			std::swap(source, destination);
+			++m_sortPassCount;
+		}
+
+		// an odd number of passes leaves the result in the scratch buffer
+		if (source != &m_entries) std::swap(m_entries, m_scratch);
+	}
+}
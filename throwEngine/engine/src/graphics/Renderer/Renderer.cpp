@@ -10,6 +10,9 @@
 
 #include "core/Logger.h"
 #include "core/Debug.h"
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
 #define DEBUG_PTR(ptr) DEBUG::DebugForEngineObjectPointers(ptr)
 
 
@@ -22,7 +25,7 @@ namespace Graphics
 	}
 
 
-	void Renderer::draw(std::shared_ptr<SCENE::Scene>& scene, const glm::mat4& view, const glm::mat4& projection) const
+	void Renderer::draw(std::shared_ptr<SCENE::Scene>& scene)
 	{
 		/* do it some stuff */
 		if (!m_renderData) {
@@ -35,8 +38,24 @@ namespace Graphics
 			return;
 		}
 
-		scene->updateInputComponents();
+		drawWorld(scene->getWorld());
+
+		// objects marked this frame are destroyed only after they were drawn
+		scene->cleanUp();
+	}
+
+	void Renderer::drawWorld(World& world)
+	{
+		if (!m_renderData || !m_renderData->getCamera()) {
+			Logger::warn("[Renderer::drawWorld] m_renderData or its camera is nullptr!");
+			return;
+		}
+
+		// one upload per frame, every program reads view/projection/camera from the FrameData block
+		int width = 0, height = 0;
+		glfwGetFramebufferSize(glfwGetCurrentContext(), &width, &height);
+		m_frameData.update(*m_renderData->getCamera(), static_cast<float>(glfwGetTime()), glm::vec2(width, height));
 
-		scene->drawAllObjects(view, projection, m_renderData);
+		m_meshRenderSystem.render(world, *m_renderData->getCamera(), *m_renderData, m_threadPool);
 	}
 }
\ No newline at end of file
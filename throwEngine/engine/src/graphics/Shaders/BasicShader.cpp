@@ -14,6 +14,15 @@
 #include "core/Debug.h"
 #define DEBUG_PTR(ptr) DEBUG::DebugForEngineObjectPointers(ptr)
 
+namespace
+{
+    const core::NameId MATERIAL_AMBIENT("material.ambient");
+    const core::NameId MATERIAL_DIFFUSE("material.diffuse");
+    const core::NameId MATERIAL_SPECULAR("material.specular");
+    const core::NameId MATERIAL_SHININESS("material.shininess");
+    const core::NameId MODEL("model");
+}
+
 namespace SHADER
 {
     BasicShader::BasicShader(const std::shared_ptr<GLShaderProgram>& glShader)
@@ -36,10 +45,10 @@ namespace SHADER
     {
         if (!m_glProgram || !mat) return;
 
-        m_glProgram->setVec3("material.ambient",    mat->m_ambient);
-        m_glProgram->setVec3("material.diffuse",    mat->m_diffuse);
-        m_glProgram->setVec3("material.specular",   mat->m_specular);
-        m_glProgram->setFloat("material.shininess", mat->m_shininess);
+        m_glProgram->set(m_glProgram->getUniformHandle(MATERIAL_AMBIENT),   mat->m_ambient);
+        m_glProgram->set(m_glProgram->getUniformHandle(MATERIAL_DIFFUSE),   mat->m_diffuse);
+        m_glProgram->set(m_glProgram->getUniformHandle(MATERIAL_SPECULAR),  mat->m_specular);
+        m_glProgram->set(m_glProgram->getUniformHandle(MATERIAL_SHININESS), mat->m_shininess);
 
         // Diffuse texture
         // if (mat->m_diffuseTexture && mat->m_diffuseTexture->glID != 0) {
@@ -68,10 +77,8 @@ namespace SHADER
     {
         if (!m_glProgram) return;
 
-        m_glProgram->setUniform("model", model);
-        m_glProgram->setUniform("view", view);
-        m_glProgram->setUniform("projection", projection);
-        m_glProgram->setVec3("viewPos", cameraPos);
+        // view, projection and the camera position are read from the FrameData block (Render::FrameDataBuffer)
+        m_glProgram->set(m_glProgram->getUniformHandle(MODEL), model);
     }
 
 }
\ No newline at end of file
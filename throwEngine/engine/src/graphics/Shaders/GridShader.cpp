@@ -32,9 +32,8 @@ namespace SHADER
 
 	void GridShader::setMatrices(const glm::mat4& model, const glm::mat4& view, const glm::mat4& projection, const glm::vec3& cameraPos)
 	{
+		// view and projection come from the FrameData block
 		m_glProgram->setUniform("uModel",		model		);
-		m_glProgram->setUniform("uView",		view		);
-		m_glProgram->setUniform("uProjection", projection  );
 	}
 
 	// void GridShader::setShaderInterface(const std::shared_ptr<SCENE::SceneObject>& gridObject)
@@ -15,6 +15,7 @@ static auto& file = core::File::get();
 
 namespace SHADER
 {
+    const core::NameId DEFAULT_INSTANCED_SHADER("basic_instanced");
 
     bool ShaderManager::loadAllShaders() {
         const std::string configPath = SHADERS_CONFIG_PATH;
@@ -131,17 +132,21 @@ namespace SHADER
 
     void ShaderManager::addShaderInterface(const std::string& name, const std::shared_ptr<IShader>& shader)
 	{
-        if (const auto it = shaderInterfaces_.find(name); it != shaderInterfaces_.end()) {
+        if (!shaderInterfaces_.try_emplace(core::NameId(name), shader).second) {
 			Logger::info("Shader interface '" + name + "' already exists. Skipping addition.");
 		}
 		else {
-			shaderInterfaces_[name] = shader;
 			Logger::info("Shader interface '" + name + "' added successfully.");
 		}
 	}
 
 	std::shared_ptr<IShader> ShaderManager::getShaderInterface(const std::string& name)
 	{
+        return getShaderInterface(core::NameId(name));
+	}
+
+	std::shared_ptr<IShader> ShaderManager::getShaderInterface(core::NameId name)
+	{
         if (shaderInterfaces_.empty()) {
             Logger::warn("shaderInterfaces_ is empty!");
         }
@@ -150,7 +155,7 @@ namespace SHADER
             return it->second;
         }
 
-		Logger::error("Shader interface '" + name + "' not found!");
+		Logger::error("Shader interface '" + name.str() + "' not found!");
 
 		static auto fallbackShader = [this](){
             const std::string vertSource = std::string(SHADERS_DIR) + "/opengl/basic.vert";
@@ -1,7 +1,34 @@
 #include "graphics/Shaders/ShaderProgram.h"
 
+#include <cstring>
+
 #include "core/Logger.h"
 
+namespace
+{
+	// whether a uniform of uniformType can be set from a value of valueType. Besides exact matches,
+	// bools take any scalar and samplers/images take their texture unit as an int
+	bool acceptsValue(GLenum uniformType, GLenum valueType)
+	{
+		if (uniformType == valueType) return true;
+		if (uniformType == GL_BOOL) return valueType == GL_INT || valueType == GL_UNSIGNED_INT || valueType == GL_FLOAT;
+		if (valueType != GL_INT) return false;
+
+		switch (uniformType) {
+		case GL_FLOAT: case GL_FLOAT_VEC2: case GL_FLOAT_VEC3: case GL_FLOAT_VEC4:
+		case GL_INT_VEC2: case GL_INT_VEC3: case GL_INT_VEC4:
+		case GL_UNSIGNED_INT: case GL_UNSIGNED_INT_VEC2: case GL_UNSIGNED_INT_VEC3: case GL_UNSIGNED_INT_VEC4:
+		case GL_BOOL_VEC2: case GL_BOOL_VEC3: case GL_BOOL_VEC4:
+		case GL_FLOAT_MAT2: case GL_FLOAT_MAT3: case GL_FLOAT_MAT4:
+		case GL_FLOAT_MAT2x3: case GL_FLOAT_MAT2x4: case GL_FLOAT_MAT3x2:
+		case GL_FLOAT_MAT3x4: case GL_FLOAT_MAT4x2: case GL_FLOAT_MAT4x3:
+		case GL_DOUBLE: case GL_DOUBLE_VEC2: case GL_DOUBLE_VEC3: case GL_DOUBLE_VEC4:
+			return false;
+		default:
+			return true; // opaque types
+		}
+	}
+}
 
 namespace SHADER
 {
@@ -53,17 +80,11 @@ namespace SHADER
 	}
 
 	bool GLShaderProgram::hasUniform(const std::string& name) const noexcept {
-		GLint currentProgram;
-		glGetIntegerv(GL_CURRENT_PROGRAM, &currentProgram);
-
-		if (currentProgram != m_programID) {
-			Logger::error("Shader not bound when checking uniform: " + name +
-				" | expected: " + std::to_string(m_programID) +
-				" | current: " + std::to_string(currentProgram));
-			return false;
-		}
+		return getUniformHandle(name).isValid();
+	}
 
-		return glGetUniformLocation(m_programID, name.c_str()) != -1;
+	bool GLShaderProgram::hasUniform(core::NameId name) const noexcept {
+		return getUniformHandle(name).isValid();
 	}
 
 	void GLShaderProgram::cleanUp() const noexcept
@@ -100,7 +121,9 @@ namespace SHADER
 		glAttachShader(m_programID, fragment);
 		glLinkProgram(m_programID);
 
-		return checkShaderCompilingErrors(0, m_programID);
+		if (!checkShaderCompilingErrors(0, m_programID)) return false;
+		reflectUniforms();
+		return true;
 	}
 
 	bool GLShaderProgram::checkShaderCompilingErrors(const GLenum shaderType, unsigned int objectID)
@@ -155,16 +178,16 @@ namespace SHADER
 	// -------------------------- SET BOOL ----------------------------------
 	void GLShaderProgram::setBool(const std::string& name, bool value) const noexcept
 	{
-		if (const GLint loc = glGetUniformLocation(m_programID, name.c_str()); loc != -1)
-			glUniform1i(loc, static_cast<int>(value));
+		if (const UniformHandle handle = getUniformHandle(name); handle.isValid())
+			set(handle, value);
 		else
 			Logger::warn("[Warning] uniform '" + name + "' not found or optimized out!");
 	}
 
 	void GLShaderProgram::setUint(const std::string &name, uint value) const noexcept
 	{
-		if (const GLint loc = glGetUniformLocation(m_programID, name.c_str()); loc != -1)
-			glUniform1ui(loc, value); // <--- unsigned version
+		if (const UniformHandle handle = getUniformHandle(name); handle.isValid())
+			set(handle, value);
 		else
 			Logger::warn("[Warning] uniform '" + name + "' not found or optimized out!");
 	}
@@ -172,8 +195,8 @@ namespace SHADER
 	// -------------------------- SET INT ----------------------------------
 	void GLShaderProgram::setInt(const std::string& name, int value) const noexcept
 	{
-		if (const GLint loc = glGetUniformLocation(m_programID, name.c_str()); loc != -1)
-			glUniform1i(loc, value);
+		if (const UniformHandle handle = getUniformHandle(name); handle.isValid())
+			set(handle, value);
 		else
 			Logger::warn("[Warning] uniform '" + name + "' not found or optimized out!");
 	}
@@ -181,57 +204,193 @@ namespace SHADER
 	// -------------------------- SET FLOAT ----------------------------------
 	void GLShaderProgram::setFloat(const std::string& name, float value) const noexcept
 	{
-		if (const GLint loc = glGetUniformLocation(m_programID, name.c_str()); loc != -1)
-			glUniform1f(loc, value);
+		if (const UniformHandle handle = getUniformHandle(name); handle.isValid())
+			set(handle, value);
 		else
 			Logger::warn("[Warning] uniform '" + name + "' not found or optimized out!");
 	}
 	// -------------------------- SET VEC ----------------------------------
 	void GLShaderProgram::setVec2(const std::string& name, const glm::vec2& value) const noexcept
 	{
-		glUniform2fv(glGetUniformLocation(m_programID, name.c_str()), 1, &value[0]);
+		set(getUniformHandle(name), value);
 	}
 
 	void GLShaderProgram::setVec2(const std::string& name, float x, float y) const noexcept
 	{
-		glUniform2f(glGetUniformLocation(m_programID, name.c_str()), x, y);
+		set(getUniformHandle(name), glm::vec2(x, y));
 	}
 
 	void GLShaderProgram::setVec3(const std::string& name, const glm::vec3& value) const noexcept
 	{
-		if (const GLint loc = glGetUniformLocation(m_programID, name.c_str()); loc != -1)
-			glUniform3fv(loc, 1, &value[0]);
+		if (const UniformHandle handle = getUniformHandle(name); handle.isValid())
+			set(handle, value);
 		else
 			Logger::warn("[Warning] uniform '" + name + "' not found or optimized out!");
 	}
 
 	void GLShaderProgram::setVec3(const std::string& name, float x, float y, float z) const noexcept
 	{
-		glUniform3f(glGetUniformLocation(m_programID, name.c_str()), x, y, z);
+		set(getUniformHandle(name), glm::vec3(x, y, z));
 	}
 	
 	void GLShaderProgram::setVec4(const std::string& name, const glm::vec4& value) const noexcept
 	{
-		glUniform4fv(glGetUniformLocation(m_programID, name.c_str()), 1, &value[0]);
+		set(getUniformHandle(name), value);
 	}
 	void GLShaderProgram::setVec4(const std::string& name, float x, float y, float z, float w) const noexcept
 	{
-		glUniform4f(glGetUniformLocation(m_programID, name.c_str()), x, y, z, w);
+		set(getUniformHandle(name), glm::vec4(x, y, z, w));
 	}
 
 	// -------------------------- SET MAT ----------------------------------
 	void GLShaderProgram::setMat2(const std::string& name, const glm::mat2& mat) const noexcept
 	{
-		glUniformMatrix2fv(glGetUniformLocation(m_programID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+		set(getUniformHandle(name), mat);
 	}
 
 	void GLShaderProgram::setMat3(const std::string& name, const glm::mat3& mat) const noexcept
 	{
-		glUniformMatrix3fv(glGetUniformLocation(m_programID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+		set(getUniformHandle(name), mat);
 	}
 
 	void GLShaderProgram::setMat4(const std::string& name, const glm::mat4& mat) const noexcept
 	{
-		glUniformMatrix4fv(glGetUniformLocation(m_programID, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+		set(getUniformHandle(name), mat);
+	}
+
+	// -------------------------- HANDLES ----------------------------------
+	UniformHandle GLShaderProgram::getUniformHandle(core::NameId name) const noexcept
+	{
+		const auto it = m_uniformIndex.find(name);
+		return it != m_uniformIndex.end() ? UniformHandle{ it->second } : UniformHandle{};
+	}
+
+	UniformHandle GLShaderProgram::getUniformHandle(std::string_view name) const noexcept
+	{
+		// every active uniform was interned at link time, a name that was never interned can't be one
+		const core::NameId id = core::NameId::find(name);
+		return id.isValid() ? getUniformHandle(id) : UniformHandle{};
+	}
+
+	GLenum GLShaderProgram::getUniformType(UniformHandle handle) const noexcept
+	{
+		return handle.isValid() && static_cast<size_t>(handle.index) < m_uniforms.size() ? m_uniforms[handle.index].type : 0;
+	}
+
+	void GLShaderProgram::set(UniformHandle handle, bool value) const noexcept
+	{
+		const int intValue = value ? 1 : 0;
+		if (changed(handle, GL_BOOL, intValue)) glProgramUniform1i(m_programID, m_uniforms[handle.index].location, intValue);
+	}
+
+	void GLShaderProgram::set(UniformHandle handle, int value) const noexcept
+	{
+		if (changed(handle, GL_INT, value)) glProgramUniform1i(m_programID, m_uniforms[handle.index].location, value);
+	}
+
+	void GLShaderProgram::set(UniformHandle handle, uint value) const noexcept
+	{
+		if (changed(handle, GL_UNSIGNED_INT, value)) glProgramUniform1ui(m_programID, m_uniforms[handle.index].location, value);
+	}
+
+	void GLShaderProgram::set(UniformHandle handle, float value) const noexcept
+	{
+		if (changed(handle, GL_FLOAT, value)) glProgramUniform1f(m_programID, m_uniforms[handle.index].location, value);
+	}
+
+	void GLShaderProgram::set(UniformHandle handle, const glm::vec2& value) const noexcept
+	{
+		if (changed(handle, GL_FLOAT_VEC2, value)) glProgramUniform2fv(m_programID, m_uniforms[handle.index].location, 1, &value[0]);
+	}
+
+	void GLShaderProgram::set(UniformHandle handle, const glm::vec3& value) const noexcept
+	{
+		if (changed(handle, GL_FLOAT_VEC3, value)) glProgramUniform3fv(m_programID, m_uniforms[handle.index].location, 1, &value[0]);
+	}
+
+	void GLShaderProgram::set(UniformHandle handle, const glm::vec4& value) const noexcept
+	{
+		if (changed(handle, GL_FLOAT_VEC4, value)) glProgramUniform4fv(m_programID, m_uniforms[handle.index].location, 1, &value[0]);
+	}
+
+	void GLShaderProgram::set(UniformHandle handle, const glm::mat2& value) const noexcept
+	{
+		if (changed(handle, GL_FLOAT_MAT2, value)) glProgramUniformMatrix2fv(m_programID, m_uniforms[handle.index].location, 1, GL_FALSE, &value[0][0]);
+	}
+
+	void GLShaderProgram::set(UniformHandle handle, const glm::mat3& value) const noexcept
+	{
+		if (changed(handle, GL_FLOAT_MAT3, value)) glProgramUniformMatrix3fv(m_programID, m_uniforms[handle.index].location, 1, GL_FALSE, &value[0][0]);
+	}
+
+	void GLShaderProgram::set(UniformHandle handle, const glm::mat4& value) const noexcept
+	{
+		if (changed(handle, GL_FLOAT_MAT4, value)) glProgramUniformMatrix4fv(m_programID, m_uniforms[handle.index].location, 1, GL_FALSE, &value[0][0]);
+	}
+
+	template<typename T>
+	bool GLShaderProgram::changed(UniformHandle handle, GLenum valueType, const T& value) const noexcept
+	{
+		static_assert(sizeof(T) <= sizeof(Uniform::shadow));
+		if (!handle.isValid() || static_cast<size_t>(handle.index) >= m_uniforms.size()) return false;
+
+		Uniform& uniform = m_uniforms[handle.index];
+		if (!acceptsValue(uniform.type, valueType)) {
+			Logger::warn("[GLShaderProgram::set] value type " + std::to_string(valueType) + " doesn't match uniform type " + std::to_string(uniform.type));
+			return false;
+		}
+
+		if (uniform.shadowValid && std::memcmp(uniform.shadow.data(), &value, sizeof(T)) == 0) return false;
+		std::memcpy(uniform.shadow.data(), &value, sizeof(T));
+		uniform.shadowValid = true;
+		return true;
+	}
+
+	// -------------------------- REFLECTION ----------------------------------
+	void GLShaderProgram::reflectUniforms()
+	{
+		m_uniforms.clear();
+		m_uniformIndex.clear();
+
+		GLint count = 0;
+		GLint maxLength = 0;
+		glGetProgramiv(m_programID, GL_ACTIVE_UNIFORMS, &count);
+		glGetProgramiv(m_programID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+		if (count <= 0 || maxLength <= 0) return;
+
+		std::string name(static_cast<size_t>(maxLength), '\0');
+		for (GLint i = 0; i < count; ++i) {
+			GLsizei length = 0;
+			GLint size = 0;
+			GLenum type = 0;
+			glGetActiveUniform(m_programID, static_cast<GLuint>(i), maxLength, &length, &size, &type, name.data());
+			const std::string_view uniformName(name.data(), static_cast<size_t>(length));
+
+			// members of uniform blocks are active but have no location
+			const GLint location = glGetUniformLocation(m_programID, name.c_str());
+			if (location == -1) continue;
+
+			// arrays are reported once as "name[0]": "name" and "name[0]" share element 0, every other element gets its own entry
+			if (!uniformName.ends_with("[0]")) {
+				addUniform(uniformName, location, type);
+				continue;
+			}
+
+			const std::string_view baseName = uniformName.substr(0, uniformName.size() - 3);
+			addUniform(uniformName, location, type);
+			m_uniformIndex.emplace(core::NameId(baseName), static_cast<int32_t>(m_uniforms.size() - 1));
+
+			for (GLint element = 1; element < size; ++element) {
+				const std::string elementName = std::string(baseName) + "[" + std::to_string(element) + "]";
+				if (const GLint elementLocation = glGetUniformLocation(m_programID, elementName.c_str()); elementLocation != -1)
+					addUniform(elementName, elementLocation, type);
+			}
+		}
+	}
+
+	void GLShaderProgram::addUniform(std::string_view name, GLint location, GLenum type)
+	{
+		m_uniforms.push_back({ location, type });
+		m_uniformIndex.emplace(core::NameId(name), static_cast<int32_t>(m_uniforms.size() - 1));
 	}
 }
@@ -27,7 +27,7 @@ namespace Graphics
 
 		const auto texturePtr = std::make_shared<Texture>();
 
-		texturePtr->name = name;
+		texturePtr->name = core::NameId(name);
 		texturePtr->path = filePath;
 		texturePtr->width = width;
 		texturePtr->height = height;
@@ -78,11 +78,15 @@ namespace Graphics
 	}
 
 	std::shared_ptr<Texture> TextureManager::getTextureWithName(const std::string &name) {
-		if (!m_nameMap.contains(name)) {
-			Logger::warn("Texture \"" + name + "\" not found.");
-			return nullptr;
+		return getTextureWithName(core::NameId(name));
+	}
+
+	std::shared_ptr<Texture> TextureManager::getTextureWithName(core::NameId name) {
+		if (const auto it = m_nameMap.find(name); it != m_nameMap.end()) {
+			return it->second;
 		}
-		return m_nameMap[name];
+		Logger::warn("Texture \"" + name.str() + "\" not found.");
+		return nullptr;
 	}
 
 	std::shared_ptr<Texture> TextureManager::getTextureWithPath(const std::string &path) {
@@ -0,0 +1,370 @@
+#include "graphics/Transformations/TransformPool.h"
+
+#include <atomic>
+#include <cstring>
+
+#include "core/Logger.h"
+#include "core/ThreadPool.h"
+#include "Math/Math.h"
+#include "Math/SIMD.h"
+
+namespace Graphics
+{
+	namespace {
+		constexpr size_t BLOCKS_PER_JOB = 256;
+		constexpr size_t ROOTS_PER_JOB = 256;
+
+		bool anySet(const uint8_t* flags)
+		{
+			static_assert(TransformPool::BLOCK_SIZE == sizeof(uint64_t));
+			uint64_t word;
+			std::memcpy(&word, flags, sizeof(word));
+			return word != 0;
+		}
+	}
+
+	uint32_t TransformPool::create(const glm::vec3& position, const glm::vec3& eulerAngles, const glm::vec3& scale)
+	{
+		uint32_t id;
+		if (!m_freeIds.empty()) {
+			id = m_freeIds.back();
+			m_freeIds.pop_back();
+		}
+		else {
+			id = static_cast<uint32_t>(m_slotCount++);
+			grow(m_slotCount);
+		}
+
+		m_alive[id] = 1;
+		m_parent[id] = INVALID_ID;
+		++m_aliveCount;
+
+		// a new root just goes at the end of the order, no rebuild needed
+		if (!m_orderDirty) {
+			m_rootStarts.push_back(static_cast<uint32_t>(m_order.size()));
+			m_order.push_back(id);
+			m_subtreeEnd.push_back(static_cast<uint32_t>(m_order.size()));
+		}
+
+		setPosition(id, position);
+		setRotation(id, eulerAngles);
+		setScale(id, scale);
+		return id;
+	}
+
+	void TransformPool::destroy(uint32_t id)
+	{
+		if (!isValid(id)) return;
+
+		if (m_childCount[id] != 0) {
+			for (uint32_t child = 0; child < m_parent.size(); ++child) {
+				if (m_alive[child] && m_parent[child] == id) setParent(child, INVALID_ID);
+			}
+		}
+		if (m_parent[id] != INVALID_ID) --m_childCount[m_parent[id]];
+
+		m_alive[id] = 0;
+		m_parent[id] = INVALID_ID;
+		m_dirty[id] = 0;
+		m_rotationDirty[id] = 0;
+		m_subtreeDirty[id] = 0;
+		m_localMatrices[id] = glm::mat4(1.0f);
+		m_worldMatrices[id] = glm::mat4(1.0f);
+		m_freeIds.push_back(id);
+		--m_aliveCount;
+		m_orderDirty = true;
+	}
+
+	bool TransformPool::setParent(uint32_t id, uint32_t parent)
+	{
+		if (!isValid(id) || (parent != INVALID_ID && !isValid(parent))) {
+			Logger::warn("[TransformPool::setParent] invalid transform id!");
+			return false;
+		}
+		for (uint32_t ancestor = parent; ancestor != INVALID_ID; ancestor = m_parent[ancestor]) {
+			if (ancestor == id) {
+				Logger::warn("[TransformPool::setParent] parenting would create a cycle, ignored");
+				return false;
+			}
+		}
+		if (m_parent[id] == parent) return true;
+
+		if (m_parent[id] != INVALID_ID) --m_childCount[m_parent[id]];
+		if (parent != INVALID_ID) ++m_childCount[parent];
+		m_parent[id] = parent;
+		m_orderDirty = true;
+
+		// flag the new ancestors too, markDirty stops at the first already flagged node
+		m_subtreeDirty[id] = 0;
+		markDirty(id);
+		return true;
+	}
+	void TransformPool::setPosition(uint32_t id, const glm::vec3& position)
+	{
+		m_posX[id] = position.x;
+		m_posY[id] = position.y;
+		m_posZ[id] = position.z;
+		markDirty(id);
+	}
+
+	void TransformPool::setRotation(uint32_t id, const glm::vec3& eulerAngles)
+	{
+		m_eulerX[id] = eulerAngles.x;
+		m_eulerY[id] = eulerAngles.y;
+		m_eulerZ[id] = eulerAngles.z;
+		m_rotationDirty[id] = 1;
+		markDirty(id);
+	}
+
+	void TransformPool::setScale(uint32_t id, const glm::vec3& scale)
+	{
+		m_scaleX[id] = scale.x;
+		m_scaleY[id] = scale.y;
+		m_scaleZ[id] = scale.z;
+		markDirty(id);
+	}
+
+	void TransformPool::markDirty(uint32_t id)
+	{
+		m_dirty[id] = 1;
+
+		// stops at the first ancestor already flagged, everything above it is flagged too
+		for (uint32_t node = id; node != INVALID_ID && !m_subtreeDirty[node]; node = m_parent[node]) {
+			m_subtreeDirty[node] = 1;
+		}
+	}
+
+	size_t TransformPool::updateMatrices(core::ThreadPool* threadPool)
+	{
+		if (m_orderDirty) {
+			rebuildOrder();
+		}
+		++m_frame;
+
+		const size_t blockCount = m_alive.size() / BLOCK_SIZE;
+		const size_t rootCount = m_rootStarts.size();
+
+		if (!threadPool) {
+			updateBlocks(0, blockCount);
+			return propagate(0, rootCount);
+		}
+
+		// local matrices: blocks never share a slot, so chunks can be processed by any thread
+		threadPool->parallelFor(blockCount, BLOCKS_PER_JOB, [this](size_t first, size_t last) {
+			updateBlocks(first, last);
+		});
+
+		// world matrices: a root's subtree only reads and writes its own range of the order
+		std::atomic<size_t> updated = 0;
+		threadPool->parallelFor(rootCount, ROOTS_PER_JOB, [this, &updated](size_t first, size_t last) {
+			updated.fetch_add(propagate(first, last), std::memory_order_relaxed);
+		});
+		return updated.load();
+	}
+
+	void TransformPool::reserve(size_t capacity)
+	{
+		const size_t padded = (capacity + BLOCK_SIZE - 1) / BLOCK_SIZE * BLOCK_SIZE;
+		for (auto* column : { &m_posX, &m_posY, &m_posZ, &m_eulerX, &m_eulerY, &m_eulerZ,
+			&m_quatX, &m_quatY, &m_quatZ, &m_quatW, &m_scaleX, &m_scaleY, &m_scaleZ }) {
+			column->reserve(padded);
+		}
+		for (auto* flags : { &m_dirty, &m_rotationDirty, &m_alive, &m_subtreeDirty }) {
+			flags->reserve(padded);
+		}
+		m_localMatrices.reserve(padded);
+		m_worldMatrices.reserve(padded);
+		m_parent.reserve(padded);
+		m_childCount.reserve(padded);
+		m_worldChangedFrame.reserve(padded);
+	}
+
+	void TransformPool::grow(size_t minCapacity)
+	{
+		if (minCapacity <= m_alive.size()) return;
+
+		// whole blocks only, the kernels never have to handle a partial block
+		const size_t capacity = (minCapacity + BLOCK_SIZE - 1) / BLOCK_SIZE * BLOCK_SIZE;
+		for (auto* column : { &m_posX, &m_posY, &m_posZ, &m_eulerX, &m_eulerY, &m_eulerZ,
+			&m_quatX, &m_quatY, &m_quatZ, &m_scaleX, &m_scaleY, &m_scaleZ }) {
+			column->resize(capacity, 0.0f);
+		}
+		m_quatW.resize(capacity, 1.0f);
+		for (auto* flags : { &m_dirty, &m_rotationDirty, &m_alive, &m_subtreeDirty }) {
+			flags->resize(capacity, 0);
+		}
+		m_localMatrices.resize(capacity, glm::mat4(1.0f));
+		m_worldMatrices.resize(capacity, glm::mat4(1.0f));
+		m_parent.resize(capacity, INVALID_ID);
+		m_childCount.resize(capacity, 0);
+		m_worldChangedFrame.resize(capacity, 0);
+	}
+
+	void TransformPool::updateBlocks(size_t firstBlock, size_t lastBlock)
+	{
+		for (size_t block = firstBlock; block < lastBlock; ++block) {
+			const size_t base = block * BLOCK_SIZE;
+			if (!anySet(&m_dirty[base])) continue;
+
+			if (anySet(&m_rotationDirty[base])) {
+				MATH::wrapAnglesBulk(&m_eulerX[base], BLOCK_SIZE);
+				MATH::wrapAnglesBulk(&m_eulerY[base], BLOCK_SIZE);
+				MATH::wrapAnglesBulk(&m_eulerZ[base], BLOCK_SIZE);
+
+				// pitch = x, yaw = y, roll = z, like glm::quat(glm::radians(eulerAngles))
+				for (size_t id = base; id < base + BLOCK_SIZE; ++id) {
+					if (!m_rotationDirty[id]) continue;
+
+					const glm::quat q(glm::radians(glm::vec3(m_eulerX[id], m_eulerY[id], m_eulerZ[id])));
+					m_quatX[id] = q.x;
+					m_quatY[id] = q.y;
+					m_quatZ[id] = q.z;
+					m_quatW[id] = q.w;
+					m_rotationDirty[id] = 0;
+				}
+			}
+
+			// dirty flags stay up, propagate() consumes them
+			composeBlock(base);
+		}
+	}
+
+	void TransformPool::composeBlock(size_t base)
+	{
+		using MATH::SIMD::Lanes;
+
+		// upper 3x4 of T * R * S per slot, column-major like glm
+		alignas(32) float columns[12][BLOCK_SIZE];
+
+		const Lanes one = Lanes::set(1.0f);
+		const Lanes two = Lanes::set(2.0f);
+
+		// clean slots of a dirty block are recomputed too, that just rewrites the same matrix
+		for (size_t lane = 0; lane < BLOCK_SIZE; lane += Lanes::WIDTH) {
+			const size_t i = base + lane;
+
+			const Lanes x = Lanes::load(&m_quatX[i]);
+			const Lanes y = Lanes::load(&m_quatY[i]);
+			const Lanes z = Lanes::load(&m_quatZ[i]);
+			const Lanes w = Lanes::load(&m_quatW[i]);
+
+			const Lanes xx = x * x, yy = y * y, zz = z * z;
+			const Lanes xy = x * y, xz = x * z, yz = y * z;
+			const Lanes wx = w * x, wy = w * y, wz = w * z;
+
+			const Lanes sx = Lanes::load(&m_scaleX[i]);
+			const Lanes sy = Lanes::load(&m_scaleY[i]);
+			const Lanes sz = Lanes::load(&m_scaleZ[i]);
+
+			(sx * (one - two * (yy + zz))).store(&columns[0][lane]);
+			(sx * (two * (xy + wz))).store(&columns[1][lane]);
+			(sx * (two * (xz - wy))).store(&columns[2][lane]);
+
+			(sy * (two * (xy - wz))).store(&columns[3][lane]);
+			(sy * (one - two * (xx + zz))).store(&columns[4][lane]);
+			(sy * (two * (yz + wx))).store(&columns[5][lane]);
+
+			(sz * (two * (xz + wy))).store(&columns[6][lane]);
+			(sz * (two * (yz - wx))).store(&columns[7][lane]);
+			(sz * (one - two * (xx + yy))).store(&columns[8][lane]);
+
+			Lanes::load(&m_posX[i]).store(&columns[9][lane]);
+			Lanes::load(&m_posY[i]).store(&columns[10][lane]);
+			Lanes::load(&m_posZ[i]).store(&columns[11][lane]);
+		}
+
+		for (size_t lane = 0; lane < BLOCK_SIZE; ++lane) {
+			glm::mat4& m = m_localMatrices[base + lane];
+			m[0] = glm::vec4(columns[0][lane], columns[1][lane], columns[2][lane], 0.0f);
+			m[1] = glm::vec4(columns[3][lane], columns[4][lane], columns[5][lane], 0.0f);
+			m[2] = glm::vec4(columns[6][lane], columns[7][lane], columns[8][lane], 0.0f);
+			m[3] = glm::vec4(columns[9][lane], columns[10][lane], columns[11][lane], 1.0f);
+		}
+	}
+
+	void TransformPool::rebuildOrder()
+	{
+		// children per parent, packed (counting sort on the parent id)
+		const size_t capacity = m_alive.size();
+		std::vector<uint32_t> childStart(capacity + 1, 0);
+		for (uint32_t id = 0; id < capacity; ++id) {
+			if (m_alive[id] && m_parent[id] != INVALID_ID) ++childStart[m_parent[id] + 1];
+		}
+		for (size_t i = 0; i < capacity; ++i) {
+			childStart[i + 1] += childStart[i];
+		}
+		std::vector<uint32_t> children(childStart[capacity]);
+		std::vector<uint32_t> fill(childStart.begin(), childStart.end() - 1);
+		for (uint32_t id = 0; id < capacity; ++id) {
+			if (m_alive[id] && m_parent[id] != INVALID_ID) children[fill[m_parent[id]]++] = id;
+		}
+
+		m_order.clear();
+		m_subtreeEnd.clear();
+		m_rootStarts.clear();
+		m_order.reserve(m_aliveCount);
+		m_subtreeEnd.reserve(m_aliveCount);
+
+		// iterative pre-order walk, subtree ends are patched once a node's children are all emitted
+		std::vector<std::pair<uint32_t, uint32_t>> stack; // (position in m_order, next child index)
+		for (uint32_t root = 0; root < capacity; ++root) {
+			if (!m_alive[root] || m_parent[root] != INVALID_ID) continue;
+
+			m_rootStarts.push_back(static_cast<uint32_t>(m_order.size()));
+			m_order.push_back(root);
+			m_subtreeEnd.push_back(0);
+			stack.emplace_back(static_cast<uint32_t>(m_order.size() - 1), childStart[root]);
+
+			while (!stack.empty()) {
+				auto& [position, nextChild] = stack.back();
+				const uint32_t node = m_order[position];
+
+				if (nextChild == childStart[node + 1]) {
+					m_subtreeEnd[position] = static_cast<uint32_t>(m_order.size());
+					stack.pop_back();
+					continue;
+				}
+
+				const uint32_t child = children[nextChild++];
+				m_order.push_back(child);
+				m_subtreeEnd.push_back(0);
+				stack.emplace_back(static_cast<uint32_t>(m_order.size() - 1), childStart[child]);
+			}
+		}
+
+		m_orderDirty = false;
+	}
+
+	size_t TransformPool::propagate(size_t firstRoot, size_t lastRoot)
+	{
+		size_t updated = 0;
+
+		for (size_t root = firstRoot; root < lastRoot; ++root) {
+			const uint32_t rootStart = m_rootStarts[root];
+			const uint32_t rootEnd = m_subtreeEnd[rootStart];
+
+			uint32_t position = rootStart;
+			while (position < rootEnd) {
+				const uint32_t id = m_order[position];
+				const uint32_t parent = m_parent[id];
+				const bool parentChanged = parent != INVALID_ID && m_worldChangedFrame[parent] == m_frame;
+
+				// nothing dirty below and the parent didn't move: the whole subtree is up to date
+				if (!m_subtreeDirty[id] && !parentChanged) {
+					position = m_subtreeEnd[position];
+					continue;
+				}
+
+				if (m_dirty[id] || parentChanged) {
+					m_worldMatrices[id] = parent == INVALID_ID ? m_localMatrices[id] : m_worldMatrices[parent] * m_localMatrices[id];
+					m_worldChangedFrame[id] = m_frame;
+					++updated;
+				}
+				m_dirty[id] = 0;
+				m_subtreeDirty[id] = 0;
+				++position;
+			}
+		}
+		return updated;
+	}
+}
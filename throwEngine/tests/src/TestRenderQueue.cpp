@@ -0,0 +1,93 @@
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "core/ThreadPool.h"
+#include "graphics/Renderer/RenderQueue.h"
+
+namespace
+{
+	int g_failures = 0;
+
+	void check(bool condition, const std::string& name)
+	{
+		if (condition) return;
+		++g_failures;
+		std::cout << "FAILED: " << name << "\n";
+	}
+
+	// keys made the way MeshRenderSystem makes them: few shaders, some textures and meshes, many depths
+	uint64_t realisticKey(std::mt19937_64& rng)
+	{
+		using namespace Render::SortKey;
+		const auto state = makeState(Pass::Opaque, static_cast<uint32_t>(rng() % 3), static_cast<uint32_t>(rng() % 40),
+			static_cast<uint32_t>(rng() % 200), static_cast<uint32_t>(rng() % 500));
+		return state | depthBits(std::uniform_real_distribution<float>(0.1f, 500.0f)(rng));
+	}
+
+	// sorts the same keys with RenderQueue and std::stable_sort (items are push order, so stability is checked too)
+	void compare(const std::vector<uint64_t>& keys, core::ThreadPool* threadPool, const std::string& name)
+	{
+		Render::RenderQueue queue;
+		queue.reserve(keys.size());
+		for (size_t i = 0; i < keys.size(); ++i) queue.push(keys[i], static_cast<uint32_t>(i));
+
+		std::vector<Render::RenderQueue::Entry> expected = queue.getEntries();
+		std::stable_sort(expected.begin(), expected.end(), [](const auto& a, const auto& b) { return a.key < b.key; });
+
+		queue.sort(threadPool);
+		const auto& entries = queue.getEntries();
+		bool same = entries.size() == expected.size();
+		for (size_t i = 0; same && i < entries.size(); ++i) {
+			same = entries[i].key == expected[i].key && entries[i].item == expected[i].item;
+		}
+		check(same, name + (threadPool ? " (parallel)" : " (serial)") + " matches std::stable_sort");
+	}
+
+	void run(core::ThreadPool* threadPool)
+	{
+		std::mt19937_64 rng(42);
+		// below and well above RenderQueue's parallel chunk size, and not a multiple of it
+		for (const size_t count : { size_t(0), size_t(1), size_t(2), size_t(1000), size_t(100003) }) {
+			const std::string size = " x" + std::to_string(count);
+
+			std::vector<uint64_t> keys(count);
+			for (auto& key : keys) key = rng();
+			compare(keys, threadPool, "random keys" + size);
+
+			for (auto& key : keys) key = realisticKey(rng);
+			compare(keys, threadPool, "realistic keys" + size);
+
+			// every pass skipped, the queue must come back in push order
+			std::fill(keys.begin(), keys.end(), 0x0123456789abcdefull);
+			compare(keys, threadPool, "constant keys" + size);
+
+			// a single varying byte in the middle and many duplicates, exercises pass skipping with an odd pass count
+			for (auto& key : keys) key = 0xff00000000000000ull | (rng() % 7) << 24;
+			compare(keys, threadPool, "one varying byte" + size);
+		}
+
+		// pass skipping: only bytes that differ get a pass
+		Render::RenderQueue queue;
+		for (uint32_t i = 0; i < 100; ++i) queue.push(uint64_t(99 - i) << 16, i);
+		queue.sort(threadPool);
+		check(queue.getSortPassCount() == 1, "only the varying byte is sorted");
+	}
+}
+
+namespace TESTS
+{
+	int runRenderQueueTests()
+	{
+		g_failures = 0;
+
+		run(nullptr);
+		core::ThreadPool threadPool(4);
+		run(&threadPool);
+
+		std::cout << "RenderQueue: " << (g_failures == 0 ? "ok" : std::to_string(g_failures) + " failed") << "\n";
+		return g_failures;
+	}
+}
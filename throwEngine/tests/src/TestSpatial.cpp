@@ -0,0 +1,249 @@
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+#include <glm/gtc/matrix_transform.hpp>
+#include "Math/AABB.h"
+#include "Math/Frustum.h"
+#include "Spatial/DynamicBVH.h"
+#include "Spatial/SpatialHashGrid.h"
+
+namespace
+{
+	int g_failures = 0;
+
+	void check(bool condition, const std::string& name)
+	{
+		if (condition) return;
+		++g_failures;
+		std::cout << "FAILED: " << name << "\n";
+	}
+
+	constexpr float FLOAT_MAX = std::numeric_limits<float>::max();
+
+	struct SceneParams {
+		const char* name;
+		float spacing;
+		float minSize;
+		float maxSize;
+	};
+
+	// the plain list every query is checked against, indexed by userData
+	struct Reference {
+		std::vector<MATH::AABB> boxes;
+		std::vector<uint32_t> proxies;
+		std::vector<bool> alive;
+	};
+
+	MATH::AABB randomBox(std::mt19937& rng, const SceneParams& params)
+	{
+		std::uniform_real_distribution<float> position(-params.spacing, params.spacing);
+		std::uniform_real_distribution<float> size(params.minSize, params.maxSize);
+		const glm::vec3 center(position(rng), position(rng), position(rng));
+		const glm::vec3 extents(size(rng), size(rng), size(rng));
+		return { center - extents * 0.5f, center + extents * 0.5f };
+	}
+
+	glm::vec3 randomPoint(std::mt19937& rng, const SceneParams& params)
+	{
+		// a bit past the scene so some queries start outside every box
+		std::uniform_real_distribution<float> position(-params.spacing * 1.25f, params.spacing * 1.25f);
+		return { position(rng), position(rng), position(rng) };
+	}
+
+	glm::vec3 randomDirection(std::mt19937& rng)
+	{
+		std::normal_distribution<float> axis;
+		glm::vec3 direction(axis(rng), axis(rng), axis(rng));
+		// axis aligned rays give infinite 1/direction components, worth covering
+		if (rng() % 8 == 0) direction = glm::vec3(0.0f);
+		if (glm::dot(direction, direction) < 1e-6f) direction[rng() % 3] = rng() % 2 ? 1.0f : -1.0f;
+		return glm::normalize(direction);
+	}
+
+	bool sameDistance(float a, float b)
+	{
+		return std::abs(a - b) <= 1e-5f * std::max(1.0f, std::abs(b));
+	}
+
+	template<typename Collect>
+	std::vector<uint32_t> sorted(Collect&& collect)
+	{
+		std::vector<uint32_t> result;
+		collect(result);
+		std::sort(result.begin(), result.end());
+		return result;
+	}
+
+	template<typename Filter>
+	std::vector<uint32_t> linearScan(const Reference& reference, Filter&& filter)
+	{
+		std::vector<uint32_t> result;
+		for (uint32_t userData = 0; userData < reference.boxes.size(); ++userData) {
+			if (reference.alive[userData] && filter(reference.boxes[userData])) result.push_back(userData);
+		}
+		return result;
+	}
+
+	template<typename Index>
+	void compareQueries(const Index& index, const Reference& reference, std::mt19937& rng, const SceneParams& params,
+	                    const std::string& name)
+	{
+		size_t aliveCount = 0;
+		for (const bool alive : reference.alive) aliveCount += alive;
+		check(index.getProxyCount() == aliveCount, name + " proxy count");
+
+		bool overlapOk = true;
+		bool sphereOk = true;
+		bool frustumOk = true;
+		bool rayOk = true;
+		bool rayMaxTOk = true;
+		bool nearestOk = true;
+		bool nearestMaxDistanceOk = true;
+
+		for (int query = 0; query < 64; ++query) {
+			// duplicates would show up as a size mismatch, so results are compared as sorted lists, not sets
+			const MATH::AABB box = randomBox(rng, { "", params.spacing, params.spacing * 0.05f, params.spacing * 0.5f });
+			overlapOk &= sorted([&](auto& out) { index.queryOverlap(box, [&](uint32_t u) { out.push_back(u); return true; }); })
+				== linearScan(reference, [&](const MATH::AABB& b) { return b.overlaps(box); });
+
+			const glm::vec3 center = randomPoint(rng, params);
+			const float radius = std::uniform_real_distribution<float>(0.0f, params.spacing * 0.3f)(rng);
+			sphereOk &= sorted([&](auto& out) { index.querySphere(center, radius, [&](uint32_t u) { out.push_back(u); return true; }); })
+				== linearScan(reference, [&](const MATH::AABB& b) { return b.distanceSquared(center) <= radius * radius; });
+
+			const glm::vec3 eye = randomPoint(rng, params);
+			const glm::vec3 forward = randomDirection(rng);
+			const glm::vec3 up = std::abs(forward.y) < 0.9f ? glm::vec3(0.0f, 1.0f, 0.0f) : glm::vec3(1.0f, 0.0f, 0.0f);
+			const glm::mat4 viewProjection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, params.spacing)
+				* glm::lookAt(eye, eye + forward, up);
+			const auto frustum = MATH::Frustum::fromViewProjection(viewProjection);
+			frustumOk &= sorted([&](auto& out) { index.queryFrustum(frustum, [&](uint32_t u) { out.push_back(u); return true; }); })
+				== linearScan(reference, [&](const MATH::AABB& b) { return frustum.intersects(b); });
+
+			const glm::vec3 origin = randomPoint(rng, params);
+			const glm::vec3 direction = randomDirection(rng);
+			const glm::vec3 invDir = 1.0f / direction;
+			for (const float maxT : { FLOAT_MAX, params.spacing * 0.25f }) {
+				float expected = FLOAT_MAX;
+				for (const uint32_t u : linearScan(reference, [](const MATH::AABB&) { return true; })) {
+					float tEnter = 0.0f;
+					if (MATH::rayIntersectsAABB(origin, invDir, maxT, reference.boxes[u], tEnter)) expected = std::min(expected, tEnter);
+				}
+				const SPATIAL::QueryHit hit = index.raycastClosest(origin, direction, maxT);
+				const bool ok = hit.hit == (expected != FLOAT_MAX) && (!hit.hit || sameDistance(hit.distance, expected))
+					&& (!hit.hit || hit.userData < reference.boxes.size() && reference.alive[hit.userData]);
+				(maxT == FLOAT_MAX ? rayOk : rayMaxTOk) &= ok;
+			}
+
+			const glm::vec3 point = randomPoint(rng, params);
+			for (const float maxDistance : { FLOAT_MAX, params.spacing * 0.1f }) {
+				const float limit = maxDistance == FLOAT_MAX ? FLOAT_MAX : maxDistance * maxDistance;
+				float expected = FLOAT_MAX;
+				bool expectedHit = false;
+				for (const uint32_t u : linearScan(reference, [](const MATH::AABB&) { return true; })) {
+					const float distance = reference.boxes[u].distanceSquared(point);
+					if (distance <= limit && distance <= expected) {
+						expected = distance;
+						expectedHit = true;
+					}
+				}
+				const SPATIAL::QueryHit hit = index.nearest(point, maxDistance);
+				const bool ok = hit.hit == expectedHit && (!hit.hit || sameDistance(hit.distance, expected))
+					&& (!hit.hit || hit.userData < reference.boxes.size() && reference.alive[hit.userData]
+						&& sameDistance(reference.boxes[hit.userData].distanceSquared(point), hit.distance));
+				(maxDistance == FLOAT_MAX ? nearestOk : nearestMaxDistanceOk) &= ok;
+			}
+		}
+
+		check(overlapOk, name + " queryOverlap");
+		check(sphereOk, name + " querySphere");
+		check(frustumOk, name + " queryFrustum");
+		check(rayOk, name + " raycastClosest");
+		check(rayMaxTOk, name + " raycastClosest with maxT");
+		check(nearestOk, name + " nearest");
+		check(nearestMaxDistanceOk, name + " nearest with maxDistance");
+	}
+
+	template<typename Index>
+	void run(Index index, const char* indexName, const SceneParams& params, uint32_t seed)
+	{
+		const std::string name = std::string(indexName) + " " + params.name;
+		std::mt19937 rng(seed);
+		Reference reference;
+
+		const auto create = [&](const MATH::AABB& box) {
+			const auto userData = static_cast<uint32_t>(reference.boxes.size());
+			reference.boxes.push_back(box);
+			reference.proxies.push_back(index.createProxy(box, userData));
+			reference.alive.push_back(true);
+		};
+
+		compareQueries(index, reference, rng, params, name + " empty");
+
+		for (int i = 0; i < 1000; ++i) create(randomBox(rng, params));
+		compareQueries(index, reference, rng, params, name);
+
+		for (int round = 0; round < 4; ++round) {
+			const std::string churn = name + " churn " + std::to_string(round);
+			std::uniform_real_distribution<float> nudge(-params.minSize, params.minSize);
+
+			for (uint32_t u = 0; u < reference.boxes.size(); ++u) {
+				if (!reference.alive[u]) continue;
+				const uint32_t roll = rng() % 8;
+				if (roll == 0) {
+					index.destroyProxy(reference.proxies[u]);
+					reference.alive[u] = false;
+				} else if (roll == 1) {
+					// jump anywhere, usually to another cell / far across the tree
+					reference.boxes[u] = randomBox(rng, params);
+					index.moveProxy(reference.proxies[u], reference.boxes[u]);
+				} else if (roll <= 4) {
+					// small nudge, mostly within the fat box / the same cell
+					const glm::vec3 offset(nudge(rng), nudge(rng), nudge(rng));
+					reference.boxes[u] = { reference.boxes[u].min + offset, reference.boxes[u].max + offset };
+					index.moveProxy(reference.proxies[u], reference.boxes[u]);
+				}
+			}
+			// recycled proxy ids
+			for (int i = 0; i < 100; ++i) create(randomBox(rng, params));
+
+			compareQueries(index, reference, rng, params, churn);
+		}
+
+		for (uint32_t u = 0; u < reference.boxes.size(); ++u) {
+			if (!reference.alive[u]) continue;
+			index.destroyProxy(reference.proxies[u]);
+			reference.alive[u] = false;
+		}
+		compareQueries(index, reference, rng, params, name + " emptied");
+	}
+}
+
+namespace TESTS
+{
+	int runSpatialTests()
+	{
+		g_failures = 0;
+
+		// cellSize is 8 for the grid: dense and small, sparse (most cells empty), and boxes bigger than a cell (overflow list)
+		const SceneParams scenes[] = {
+			{ "dense", 40.0f, 0.5f, 3.0f },
+			{ "sparse", 2000.0f, 0.5f, 3.0f },
+			{ "oversized", 60.0f, 0.5f, 20.0f },
+		};
+
+		uint32_t seed = 1;
+		for (const auto& scene : scenes) {
+			run(SPATIAL::DynamicBVH(), "DynamicBVH", scene, seed);
+			run(SPATIAL::SpatialHashGrid(), "SpatialHashGrid", scene, seed);
+			++seed;
+		}
+
+		std::cout << "Spatial: " << (g_failures == 0 ? "ok" : std::to_string(g_failures) + " failed") << "\n";
+		return g_failures;
+	}
+}
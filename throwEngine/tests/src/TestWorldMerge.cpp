@@ -0,0 +1,210 @@
+#include <cstdint>
+#include <iostream>
+#include <set>
+#include <string>
+#include <vector>
+#include "World.h"
+
+namespace
+{
+	struct Position { float x; };
+	struct Velocity { float x; };
+
+	int g_failures = 0;
+
+	void check(bool condition, const std::string& name)
+	{
+		if (condition) return;
+		++g_failures;
+		std::cout << "FAILED: " << name << "\n";
+	}
+
+	// n entities with Position{ i }, every other one also with Velocity{ -i }, slots 3 and 5 (if any) freed again
+	World makeSource(int n, float base)
+	{
+		World world;
+		std::vector<Entity> entities;
+		for (int i = 0; i < n; ++i) {
+			const Entity e = world.createEntity();
+			entities.push_back(e);
+			world.addComponent<Position>(e, Position{ base + static_cast<float>(i) });
+			if (i % 2 == 0) world.addComponent<Velocity>(e, Velocity{ -(base + static_cast<float>(i)) });
+		}
+		if (n > 3) world.deleteEntity(entities[2]);
+		if (n > 5) world.deleteEntity(entities[4]);
+		return world;
+	}
+
+	// what a source world holds, by slot index, taken before it is merged away
+	struct Expected {
+		std::vector<bool> alive;
+		std::vector<float> positionValue;
+		std::vector<bool> hasVelocity;
+		std::vector<float> velocityValue;
+	};
+
+	Expected snapshot(World& world, size_t slots)
+	{
+		Expected expected;
+		for (uint32_t index = 0; index < slots; ++index) {
+			Entity e = ECS::NullEntity;
+			for (uint32_t generation = 0; generation < 4 && e == ECS::NullEntity; ++generation) {
+				if (world.isAlive(ECS::makeEntity(index, generation))) e = ECS::makeEntity(index, generation);
+			}
+			expected.alive.push_back(e != ECS::NullEntity);
+			const Position* position = e != ECS::NullEntity ? world.getStorage<Position>().get(e) : nullptr;
+			const Velocity* velocity = e != ECS::NullEntity ? world.getStorage<Velocity>().get(e) : nullptr;
+			expected.positionValue.push_back(position ? position->x : 0.0f);
+			expected.hasVelocity.push_back(velocity != nullptr);
+			expected.velocityValue.push_back(velocity ? velocity->x : 0.0f);
+		}
+		return expected;
+	}
+
+	// remap[i] is a distinct live handle with slot i's components for every live slot of the source, null otherwise
+	void checkRemap(World& world, const std::vector<Entity>& remap, const Expected& expected, const std::string& name)
+	{
+		check(remap.size() == expected.alive.size(), name + ": remap has one entry per source slot");
+		std::set<Entity> seen;
+		for (size_t index = 0; index < remap.size() && index < expected.alive.size(); ++index) {
+			const Entity e = remap[index];
+			if (!expected.alive[index]) {
+				check(e == ECS::NullEntity, name + ": free source slot maps to NullEntity");
+				continue;
+			}
+			check(world.isAlive(e), name + ": imported entity is alive");
+			check(seen.insert(e).second, name + ": imported handles are distinct");
+
+			const Position* position = world.getStorage<Position>().get(e);
+			check(position && position->x == expected.positionValue[index], name + ": Position follows the remap");
+			const Velocity* velocity = world.getStorage<Velocity>().get(e);
+			check((velocity != nullptr) == expected.hasVelocity[index], name + ": Velocity membership follows the remap");
+			if (velocity) check(velocity->x == expected.velocityValue[index], name + ": Velocity follows the remap");
+		}
+	}
+
+	// every pooled entity is alive and its sparse slot leads back to it
+	template<typename T>
+	void checkPool(World& world, const std::string& name)
+	{
+		auto& pool = world.getStorage<T>();
+		for (const Entity e : pool.getEntities()) {
+			check(e != ECS::NullEntity && world.isAlive(e) && pool.contains(e), name + ": pool entries are consistent");
+		}
+	}
+}
+
+namespace TESTS
+{
+	int runWorldMergeTests()
+	{
+		g_failures = 0;
+
+		// a world that never handed out a handle takes the other one over, handles stay as they were
+		{
+			World world;
+			World source = makeSource(8, 0.0f);
+			const Expected expected = snapshot(source, 9);
+			const auto remap = world.merge(std::move(source));
+			checkRemap(world, remap, expected, "fast path");
+			for (size_t index = 1; index < remap.size(); ++index) {
+				if (remap[index] != ECS::NullEntity) check(ECS::getIndex(remap[index]) == index, "fast path keeps slot indices");
+			}
+			check(source.getAliveCount() == 0, "fast path leaves the source empty");
+		}
+
+		// a handle given out and deleted before the merge must stay dead, even if the source holds the same handle
+		{
+			World world;
+			const Entity stale = world.createEntity();
+			world.deleteEntity(stale);
+
+			World source;
+			const Entity imported = source.createEntity();
+			source.addComponent<Position>(imported, Position{ 7.0f });
+			check(imported == stale, "source reuses the stale handle value");
+
+			const auto remap = world.merge(std::move(source));
+			check(!world.isAlive(stale), "stale handle stays dead after merging into an emptied world");
+			check(world.isAlive(remap[1]) && remap[1] != stale, "imported entity gets a newer generation");
+			check(world.getStorage<Position>().get(remap[1]) && world.getStorage<Position>().get(remap[1])->x == 7.0f,
+				"imported entity keeps its component");
+			checkPool<Position>(world, "emptied world");
+
+			// the slots nobody imported are handed out again
+			check(world.getAliveCount() == 1, "emptied world counts only the imported entity");
+			const Entity next = world.createEntity();
+			check(world.isAlive(next) && next != stale && next != remap[1], "emptied world hands out fresh handles");
+		}
+
+		// populated world with an owning group: imported entities are spliced in and land in the packed range
+		{
+			World world;
+			std::vector<Entity> existing;
+			for (int i = 0; i < 6; ++i) {
+				const Entity e = world.createEntity();
+				existing.push_back(e);
+				world.addComponent<Position>(e, Position{ 100.0f + static_cast<float>(i) });
+				if (i % 3 != 0) world.addComponent<Velocity>(e, Velocity{ -100.0f - static_cast<float>(i) });
+			}
+			world.deleteEntity(existing[1]);
+			auto& group = world.group<Position, Velocity>();
+			const size_t groupedBefore = group.size();
+
+			World source = makeSource(10, 0.0f);
+			const Expected expected = snapshot(source, 11);
+			size_t importedWithBoth = 0;
+			for (size_t index = 0; index < expected.alive.size(); ++index) {
+				importedWithBoth += expected.alive[index] && expected.hasVelocity[index];
+			}
+
+			const auto remap = world.merge(std::move(source));
+			checkRemap(world, remap, expected, "populated merge");
+			checkPool<Position>(world, "populated merge");
+			checkPool<Velocity>(world, "populated merge");
+			check(!world.isAlive(existing[1]), "populated merge keeps deleted handles dead");
+			for (size_t i = 0; i < existing.size(); ++i) {
+				if (i == 1) continue;
+				check(world.isAlive(existing[i]) && world.getStorage<Position>().get(existing[i])->x == 100.0f + static_cast<float>(i),
+					"populated merge keeps existing entities");
+			}
+
+			check(group.size() == groupedBefore + importedWithBoth, "group packs every imported entity with both components");
+			size_t walked = 0;
+			bool consistent = true;
+			group.each([&](Entity e, Position& position, Velocity& velocity) {
+				++walked;
+				consistent = consistent && position.x == -velocity.x && group.contains(e);
+			});
+			check(walked == group.size() && consistent, "group range holds matching Position/Velocity pairs");
+		}
+
+		// a merge that doesn't fit the index space is rejected as a whole and leaves both worlds alone
+		{
+			World world;
+			world.reserveEntities(ECS::ENTITY_INDEX_MASK);
+			Entity e = world.createEntity();
+			world.addComponent<Position>(e, Position{ 1.0f });
+			while (world.createEntity() != ECS::NullEntity) {}
+			const size_t aliveBefore = world.getAliveCount();
+			const size_t pooledBefore = world.getStorage<Position>().size();
+
+			World source = makeSource(4, 0.0f);
+			const size_t sourceAlive = source.getAliveCount();
+			const auto remap = world.merge(std::move(source));
+
+			bool allNull = true;
+			for (const Entity imported : remap) allNull = allNull && imported == ECS::NullEntity;
+			check(allNull, "rejected merge returns an all-null remap");
+			check(world.getAliveCount() == aliveBefore && world.getStorage<Position>().size() == pooledBefore,
+				"rejected merge leaves the target world alone");
+			check(source.getAliveCount() == sourceAlive && source.getStorage<Position>().size() == sourceAlive,
+				"rejected merge leaves the source world alone");
+			check(world.getStorage<Position>().get(e) && world.getStorage<Position>().get(e)->x == 1.0f,
+				"rejected merge keeps existing components");
+		}
+
+		std::cout << "WorldMerge: " << (g_failures == 0 ? "ok" : std::to_string(g_failures) + " failed") << "\n";
+		return g_failures;
+	}
+}
@@ -0,0 +1,150 @@
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "World.h"
+#include "WorldSnapshot.h"
+
+namespace
+{
+	struct Health { int value; };
+
+	// offsets into a version 1 file, see WorldSnapshot.h for the layout
+	constexpr size_t SLOT_COUNT_OFFSET = 12;
+	constexpr size_t FREE_COUNT_OFFSET = 16;
+	constexpr size_t SLOTS_OFFSET = 48;
+	constexpr size_t POOL_ENTRY_SIZE = 32;
+	constexpr size_t POOL_ENTITIES_OFFSET = 16;
+
+	using Bytes = std::vector<std::byte>;
+
+	uint64_t alignUp(uint64_t offset) { return (offset + 15) / 16 * 16; }
+
+	template<typename T>
+	T read(const Bytes& bytes, size_t offset)
+	{
+		T value{};
+		std::memcpy(&value, bytes.data() + offset, sizeof(T));
+		return value;
+	}
+
+	template<typename T>
+	void write(Bytes& bytes, size_t offset, T value)
+	{
+		std::memcpy(bytes.data() + offset, &value, sizeof(T));
+	}
+
+	// where the tables of a (valid) snapshot start
+	struct Layout {
+		uint32_t slotCount;
+		uint32_t freeCount;
+		size_t freeOffset;
+		size_t firstPoolEntities;
+
+		explicit Layout(const Bytes& bytes)
+			: slotCount(read<uint32_t>(bytes, SLOT_COUNT_OFFSET)), freeCount(read<uint32_t>(bytes, FREE_COUNT_OFFSET))
+		{
+			freeOffset = alignUp(SLOTS_OFFSET + slotCount * sizeof(Entity));
+			const size_t tableOffset = alignUp(freeOffset + freeCount * sizeof(uint32_t));
+			firstPoolEntities = static_cast<size_t>(read<uint64_t>(bytes, tableOffset + POOL_ENTITIES_OFFSET));
+		}
+
+		[[nodiscard]] size_t slot(uint32_t index) const { return SLOTS_OFFSET + index * sizeof(Entity); };
+		[[nodiscard]] size_t freeIndex(uint32_t i) const { return freeOffset + i * sizeof(uint32_t); };
+		[[nodiscard]] size_t poolEntity(uint32_t i) const { return firstPoolEntities + i * sizeof(Entity); };
+	};
+
+	Bytes readFile(const std::string& path)
+	{
+		std::ifstream file(path, std::ios::binary | std::ios::ate);
+		Bytes bytes(static_cast<size_t>(file.tellg()));
+		file.seekg(0);
+		file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+		return bytes;
+	}
+
+	void writeFile(const std::string& path, const Bytes& bytes)
+	{
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+	}
+
+	// slots 1..6, 2 and 4 freed, Health on every live entity
+	World makeWorld()
+	{
+		World world;
+		std::vector<Entity> entities;
+		for (int i = 0; i < 6; ++i) entities.push_back(world.createEntity());
+		world.deleteEntity(entities[1]);
+		world.deleteEntity(entities[3]);
+		for (const Entity e : entities) {
+			if (world.isAlive(e)) world.addComponent<Health>(e, Health{ static_cast<int>(ECS::getIndex(e)) });
+		}
+		return world;
+	}
+
+	int g_failures = 0;
+
+	void check(bool condition, const std::string& name)
+	{
+		if (condition) return;
+		++g_failures;
+		std::cout << "FAILED: " << name << "\n";
+	}
+}
+
+namespace TESTS
+{
+	int runWorldSnapshotTests()
+	{
+		g_failures = 0;
+		WorldSnapshot::registerType<Health>("test.Health");
+
+		const std::string path = (std::filesystem::temp_directory_path() / "throw_tests_snapshot.bin").string();
+		check(WorldSnapshot::save(makeWorld(), path), "save");
+		const Bytes valid = readFile(path);
+		const Layout layout(valid);
+
+		{
+			World world;
+			check(WorldSnapshot::load(world, path), "valid snapshot loads");
+			check(world.getAliveCount() == 4, "valid snapshot keeps the alive count");
+			// the freed slots are handed out again, not appended
+			check(ECS::getIndex(world.createEntity()) <= 4, "valid snapshot reuses a free slot");
+		}
+
+		// every corruption must be rejected and leave the target world untouched
+		const auto rejects = [&](const std::string& name, const std::function<void(Bytes&)>& corrupt) {
+			Bytes bytes = valid;
+			corrupt(bytes);
+			writeFile(path, bytes);
+
+			World world;
+			const Entity existing = world.createEntity();
+			check(!WorldSnapshot::load(world, path), name + " is rejected");
+			check(world.isAlive(existing) && world.getAliveCount() == 1, name + " leaves the world untouched");
+		};
+
+		rejects("freeCount >= slotCount", [&](Bytes& bytes) { write<uint32_t>(bytes, FREE_COUNT_OFFSET, layout.slotCount); });
+		rejects("slot 0 not NullEntity", [&](Bytes& bytes) { write<Entity>(bytes, layout.slot(0), ECS::makeEntity(3, 0)); });
+		rejects("free index 0", [&](Bytes& bytes) { write<uint32_t>(bytes, layout.freeIndex(0), 0); });
+		rejects("free index out of range", [&](Bytes& bytes) { write<uint32_t>(bytes, layout.freeIndex(0), layout.slotCount + 100); });
+		rejects("free index listed twice", [&](Bytes& bytes) {
+			write<uint32_t>(bytes, layout.freeIndex(1), read<uint32_t>(bytes, layout.freeIndex(0)));
+		});
+		rejects("free index of a live slot", [&](Bytes& bytes) { write<uint32_t>(bytes, layout.freeIndex(0), 1); });
+		rejects("live slot with a foreign index", [&](Bytes& bytes) { write<Entity>(bytes, layout.slot(3), ECS::makeEntity(5, 0)); });
+		rejects("entity listed twice in a pool", [&](Bytes& bytes) {
+			write<Entity>(bytes, layout.poolEntity(1), read<Entity>(bytes, layout.poolEntity(0)));
+		});
+
+		std::filesystem::remove(path);
+		std::cout << "WorldSnapshot: " << (g_failures == 0 ? "ok" : std::to_string(g_failures) + " failed") << "\n";
+		return g_failures;
+	}
+}
@@ -0,0 +1,23 @@
+#include <iostream>
+
+namespace TESTS
+{
+	int runWorldSnapshotTests();
+	int runWorldMergeTests();
+	int runRenderQueueTests();
+	int runSpatialTests();
+}
+
+// every suite runs, the exit code is the number of failed checks
+int main()
+{
+	int failures = 0;
+	failures += TESTS::runWorldSnapshotTests();
+	failures += TESTS::runWorldMergeTests();
+	failures += TESTS::runRenderQueueTests();
+	failures += TESTS::runSpatialTests();
+
+	if (failures == 0) std::cout << "all tests passed\n";
+	else std::cout << failures << " check(s) failed\n";
+	return failures;
+}